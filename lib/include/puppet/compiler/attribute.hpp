@@ -13,8 +13,11 @@ namespace puppet { namespace compiler {
 
     /**
      * Represents a resource attribute.
+     * Attribute names are interned and the value is stored in the attribute itself.
+     * Attributes do not keep their syntax tree alive; the resource or scope holding them does.
+     * Attributes must be created with std::make_shared so that their value can be shared.
      */
-    struct attribute
+    struct attribute : std::enable_shared_from_this<attribute>
     {
         /**
          * Constructs a resource attribute.
@@ -23,7 +26,7 @@ namespace puppet { namespace compiler {
          * @param value The attribute's value.
          * @param value_context The AST context of the value.
          */
-        attribute(std::string name, ast::context name_context, std::shared_ptr<runtime::values::value> value, ast::context value_context);
+        attribute(std::string const& name, ast::context name_context, runtime::values::value value, ast::context value_context);
 
         /**
          * Gets the name of the attribute.
@@ -51,12 +54,14 @@ namespace puppet { namespace compiler {
 
         /**
          * Gets the attribute's shared value.
+         * The returned pointer shares ownership of the attribute.
          * @return Returns the attribute's shared value.
          */
         std::shared_ptr<runtime::values::value> shared_value();
 
         /**
          * Gets the attribute's shared value.
+         * The returned pointer shares ownership of the attribute.
          * @return Returns the attribute's shared value.
          */
         std::shared_ptr<runtime::values::value const> shared_value() const;
@@ -68,17 +73,29 @@ namespace puppet { namespace compiler {
         ast::context const& value_context() const;
 
         /**
-         * Determines if any other attribute is referring to the same value as this one.
+         * Gets the syntax tree the attribute's contexts refer to.
+         * @return Returns the syntax tree or nullptr if the contexts do not refer to a tree.
+         */
+        ast::syntax_tree* tree() const;
+
+        /**
+         * Determines if the value has been shared through shared_value.
          * @return Returns true if the value is unique or false if it is shared.
          */
         bool unique() const;
 
+        /**
+         * Clears the syntax tree from the attribute's contexts.
+         * The contexts keep their positions but no longer refer to the tree.
+         */
+        void release_tree();
+
      private:
-        std::shared_ptr<ast::syntax_tree> _tree;
-        std::string _name;
+        std::string const* _name;
         ast::context _name_context;
-        std::shared_ptr<runtime::values::value> _value;
+        runtime::values::value _value;
         ast::context _value_context;
+        mutable bool _shared;
     };
 
     /**
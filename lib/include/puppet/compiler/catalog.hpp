@@ -5,13 +5,15 @@
 #pragma once
 
 #include "resource.hpp"
-#include <boost/graph/adjacency_list.hpp>
+#include <boost/graph/compressed_sparse_row_graph.hpp>
 #include <string>
 #include <memory>
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
 #include <functional>
 #include <deque>
+#include <cstdint>
 
 namespace puppet { namespace compiler {
 
@@ -50,6 +52,25 @@ namespace puppet { namespace compiler {
      */
     std::ostream& operator<<(std::ostream& out, relationship relation);
 
+    /**
+     * Represents the supported catalog output formats.
+     */
+    enum class catalog_format
+    {
+        /**
+         * Indented (human readable) JSON.
+         */
+        json,
+        /**
+         * JSON without any insignificant whitespace.
+         */
+        compact_json,
+        /**
+         * MessagePack binary encoding of the JSON document.
+         */
+        msgpack
+    };
+
     /**
      * Represents an exception when a resource cycle is detected.
      */
@@ -62,6 +83,62 @@ namespace puppet { namespace compiler {
         explicit resource_cycle_exception(std::string const& message);
     };
 
+    /**
+     * Represents the per-catalog state shared by its resources.
+     * This indexes explicitly set attribute values to find resources for collection queries and interns resource tags and paths.
+     * An attribute of a resource type is only indexed once it has been used in a collection query.
+     */
+    struct resource_index
+    {
+        /**
+         * Updates the index after an attribute is set on a resource.
+         * @param resource The resource the attribute was set on.
+         * @param attribute The attribute that was set.
+         */
+        void update(compiler::resource const& resource, compiler::attribute const& attribute);
+
+        /**
+         * Interns a resource tag.
+         * @param value The tag to intern.
+         * @return Returns the interned tag, which remains valid for the lifetime of the index.
+         */
+        std::string const* intern(std::string const& value);
+
+        /**
+         * Interns the path of a sealed resource.
+         * Paths are kept apart from tags so that tag lookups are not slowed by paths.
+         * @param path The path to intern.
+         * @return Returns the interned path, which remains valid for the lifetime of the index.
+         */
+        std::string const* intern_path(std::string const& path);
+
+        /**
+         * Gets the current tag defaults generation.
+         * The generation changes whenever a resource default for the tag metaparameter is added.
+         * Other tag changes are tracked by the resources themselves.
+         * @return Returns the current tag defaults generation.
+         */
+        size_t tag_defaults_generation() const;
+
+        /**
+         * Invalidates the calculated tags of resources that may use a tag resource default.
+         */
+        void invalidate_tag_defaults();
+
+     private:
+        friend struct catalog;
+
+        using value_map = std::unordered_map<runtime::values::value, std::vector<size_t>, boost::hash<runtime::values::value>>;
+
+        static void add(value_map& values, size_t position, runtime::values::value const& value);
+
+        std::unordered_map<std::string, std::unordered_map<std::string, value_map>> _types;
+        std::unordered_map<std::string, std::unordered_set<std::string>> _defaults;
+        std::unordered_set<std::string> _strings;
+        std::unordered_set<std::string> _paths;
+        size_t _tag_defaults_generation = 0;
+    };
+
     /**
      * Represents the Puppet catalog.
      */
@@ -135,6 +212,49 @@ namespace puppet { namespace compiler {
          */
         size_t size() const;
 
+        /**
+         * Finds a resource in the catalog by its position in the list of resources of the same type.
+         * @param type The resource type name.
+         * @param position The position of the resource, in declaration order.
+         * @return Returns the resource if found or nullptr if the position is out of range.
+         */
+        resource* find(std::string const& type, size_t position);
+
+        /**
+         * Finds the positions of resources of the given type that may have the given attribute value.
+         * A "title" attribute is found by the resource title; other attributes are indexed when first used.
+         * The positions may include resources that no longer match, so callers must still check each resource.
+         * @param type The resource type name.
+         * @param name The attribute name.
+         * @param value The value the attribute is equal to (or, for arrays, contains).
+         * @param offset The position to start from.
+         * @param positions Receives the positions (sorted and without duplicates) of the candidate resources.
+         * @return Returns true if the candidates were found or false if the attribute cannot be indexed and the resources must be scanned.
+         */
+        bool find_candidates(std::string const& type, std::string const& name, runtime::values::value const& value, size_t offset, std::vector<size_t>& positions);
+
+        /**
+         * Records that a resource default exists for the given attribute.
+         * Defaulted attributes are not served from the attribute index.
+         * @param type The resource type name.
+         * @param name The attribute name.
+         */
+        void add_default(std::string const& type, std::string const& name);
+
+        /**
+         * Gets the number of resources of the given type in the catalog.
+         * @param type The resource type name.
+         * @return Returns the number of resources of the given type.
+         */
+        size_t size(std::string const& type) const;
+
+        /**
+         * Gets the revision of the catalog.
+         * The revision changes whenever a resource is added to or realized in the catalog.
+         * @return Returns the revision of the catalog.
+         */
+        size_t revision() const;
+
         /**
          * Enumerates the resources in the catalog.
          * @param callback The callback to call for each resource.
@@ -153,6 +273,7 @@ namespace puppet { namespace compiler {
 
         /**
          * Enumerates the dependency (out) edges of the given resource.
+         * The dependency graph must have been populated before edges can be enumerated.
          * @param resource The resource to enumerate dependency edges for.
          * @param callback The callback to call for each dependency edge.
          */
@@ -161,6 +282,7 @@ namespace puppet { namespace compiler {
         /**
          * Adds a relationship (i.e. an edge) to the dependency graph.
          * The source will become dependent upon the target (reversed for before and notify relationships).
+         * Relationships cannot be added once the dependency graph has been populated.
          * @param relation The relationship from the source to the target.
          * @param source The source resource.
          * @param target The target resource.
@@ -175,15 +297,25 @@ namespace puppet { namespace compiler {
         void realize(compiler::resource& resource);
 
         /**
-         * Populate's the catalog's graph with relationships from resource metaparameters.
+         * Populates the catalog's graph with relationships from resource metaparameters.
+         * This builds the final (immutable) dependency graph; duplicate edges between two resources are merged.
          */
         void populate_graph();
 
         /**
-         * Writes the catalog as JSON.
+         * Seals the catalog by releasing the evaluation state held by its resources.
+         * Resource defaults are copied to the resources and their scopes and syntax trees are released.
+         * A sealed catalog can still be written, but its resources can no longer be evaluated against.
+         */
+        void seal();
+
+        /**
+         * Writes the catalog.
+         * All formats encode the same document; only the encoding differs.
          * @param out The output stream to write the catalog to.
+         * @param format The format to write the catalog in.
          */
-        void write(std::ostream& out) const;
+        void write(std::ostream& out, catalog_format format = catalog_format::json) const;
 
         /**
          * Writes the dependency graph as a DOT file.
@@ -201,6 +333,14 @@ namespace puppet { namespace compiler {
         catalog(catalog&) = delete;
         catalog& operator=(catalog&) = delete;
         void populate_relationships(resource const& source, std::string const& name, compiler::relationship relationship);
+        void build_graph();
+
+        struct pending_edge
+        {
+            uint32_t source;
+            uint32_t target;
+            compiler::relationship relationship;
+        };
 
         std::string _node;
         std::string _environment;
@@ -209,7 +349,15 @@ namespace puppet { namespace compiler {
         std::deque<resource> _resources;
         std::unordered_map<runtime::types::resource, resource*, boost::hash<runtime::types::resource>> _resource_map;
         std::unordered_map<std::string, std::vector<resource*>> _resource_lists;
-        boost::adjacency_list<boost::vecS, boost::vecS, boost::directedS, resource*, relationship> _graph;
+        // The index is shared with the resources, so allocate it to keep its address stable when the catalog is moved
+        std::shared_ptr<resource_index> _index;
+        // Realized resources and relationships are recorded here until the dependency graph is built
+        std::vector<resource*> _vertices;
+        std::vector<pending_edge> _edges;
+        // The dependency graph stores a bitmask of relationships for each edge
+        boost::compressed_sparse_row_graph<boost::directedS, resource*, uint8_t, boost::no_property, uint32_t, uint32_t> _graph;
+        size_t _revision;
+        bool _populated;
     };
 
 }}  // namespace puppet::compiler
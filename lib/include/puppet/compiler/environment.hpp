@@ -17,6 +17,9 @@
 #include <memory>
 #include <unordered_map>
 #include <functional>
+#include <ctime>
+#include <chrono>
+#include <cstdint>
 
 namespace puppet { namespace compiler {
 
@@ -61,6 +64,12 @@ namespace puppet { namespace compiler {
          */
         compiler::settings const& settings() const;
 
+        /**
+         * Gets the time a regular expression match may take when compiling in this environment.
+         * @return Returns the regular expression timeout; zero for no timeout.
+         */
+        std::chrono::milliseconds regex_timeout() const;
+
         /**
          * Gets the environment's registry.
          * @return Returns the environment's registry.
@@ -137,18 +146,64 @@ namespace puppet { namespace compiler {
          */
         std::string resolve_path(logging::logger& logger, find_type type, std::string const& path) const;
 
+        /**
+         * Gets the parsed and validated syntax tree for an EPP template file.
+         * The tree is cached in the environment and reused until the file's modification time or size changes.
+         * @param logger The logger to use to log messages.
+         * @param path The resolved path to the template file.
+         * @return Returns the syntax tree for the template.
+         */
+        std::shared_ptr<ast::syntax_tree> import_template(logging::logger& logger, std::string const& path);
+
+        /**
+         * Gets the parsed and validated syntax tree for an inline EPP template.
+         * The tree is cached in the environment and reused for identical template source.
+         * @param logger The logger to use to log messages.
+         * @param source The template source.
+         * @param path The path to use for the template in messages.
+         * @return Returns the syntax tree for the template.
+         */
+        std::shared_ptr<ast::syntax_tree> import_inline_template(logging::logger& logger, std::string const& source, std::string const& path);
+
+        /**
+         * Reads the contents of a file as a string value.
+         * The contents are cached in the environment and reused until the file's modification time or size changes.
+         * @param path The resolved path to the file.
+         * @return Returns the file's contents or nullptr if the file could not be read.
+         */
+        std::shared_ptr<runtime::values::value const> read_file(std::string const& path);
+
      private:
+        struct cached_file
+        {
+            std::time_t modified;
+            std::uintmax_t size;
+            std::shared_ptr<runtime::values::value const> contents;
+        };
+
+        struct cached_template
+        {
+            std::time_t modified;
+            std::uintmax_t size;
+            std::shared_ptr<ast::syntax_tree> tree;
+        };
+
         void add_modules(logging::logger& logger);
         void add_modules(logging::logger& logger, std::string const& directory);
         std::shared_ptr<ast::syntax_tree> import(logging::logger& logger, std::string const& path, compiler::module const* module = nullptr);
 
         std::string _name;
         compiler::settings _settings;
+        std::chrono::milliseconds _regex_timeout;
         compiler::registry _registry;
         evaluation::dispatcher _dispatcher;
         std::deque<module> _modules;
         std::unordered_map<std::string, module*> _module_map;
         std::unordered_map<std::string, std::shared_ptr<ast::syntax_tree>> _parsed;
+        std::unordered_map<std::string, cached_template> _templates;
+        std::unordered_map<std::string, std::shared_ptr<ast::syntax_tree>> _inline_templates;
+        std::unordered_map<std::string, cached_file> _files;
+        std::uintmax_t _files_size = 0;
     };
 
 }}  // puppet::compiler
@@ -7,6 +7,7 @@
 #include "../../ast/ast.hpp"
 #include "../../resource.hpp"
 #include <boost/optional.hpp>
+#include <unordered_map>
 
 namespace puppet { namespace compiler { namespace evaluation {
 
@@ -36,7 +37,29 @@ namespace puppet { namespace compiler { namespace evaluation { namespace collect
          */
         bool evaluate(compiler::resource const& resource) const;
 
+        /**
+         * Finds the candidate resources for the query using the catalog's indexes.
+         * Only equality queries (possibly combined with "and" and "or") can be served from the indexes.
+         * The query must still be evaluated against each candidate resource.
+         * @param type The type name of the resources being queried.
+         * @param offset The position in the list of resources of the type to start from.
+         * @param positions Receives the positions (sorted and without duplicates) of the candidate resources.
+         * @return Returns true if the candidates were found or false if the resources must be scanned.
+         */
+        bool find_candidates(std::string const& type, size_t offset, std::vector<size_t>& positions) const;
+
      private:
+        using candidates = boost::optional<std::vector<size_t>>;
+
+        candidates find_candidates(ast::basic_query_expression const& expression, std::string const& type, size_t offset) const;
+        candidates climb_candidates(
+            ast::basic_query_expression const& expression,
+            std::uint8_t min_precedence,
+            std::vector<ast::binary_query_operation>::const_iterator& begin,
+            std::vector<ast::binary_query_operation>::const_iterator const& end,
+            std::string const& type,
+            size_t offset) const;
+        runtime::values::value const& expected_value(ast::attribute_query const& query) const;
         bool evaluate(ast::basic_query_expression const& expression, compiler::resource const& resource) const;
         bool climb_expression(
             ast::basic_query_expression const& expression,
@@ -49,6 +72,7 @@ namespace puppet { namespace compiler { namespace evaluation { namespace collect
 
         evaluation::context& _context;
         boost::optional<ast::query_expression> const& _expression;
+        mutable std::unordered_map<ast::attribute_query const*, runtime::values::value> _expected;
     };
 
 }}}}  // namespace puppet::compiler::evaluation::collectors
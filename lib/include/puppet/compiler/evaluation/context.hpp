@@ -69,21 +69,21 @@ namespace puppet { namespace compiler { namespace evaluation {
     };
 
     /**
-     * Helper for scoping evaluation output streams.
+     * Helper for scoping evaluation output buffers.
      */
-    struct scoped_output_stream
+    struct scoped_output_buffer
     {
         /**
-         * Constructs a scoped output stream.
+         * Constructs a scoped output buffer.
          * @param context The current evaluation context.
-         * @param stream The stream to set in the evaluation context.
+         * @param buffer The buffer to append evaluation output to.
          */
-        scoped_output_stream(evaluation::context& context, std::ostream& stream);
+        scoped_output_buffer(evaluation::context& context, std::string& buffer);
 
         /**
-         * Destructs the scoped output stream.
+         * Destructs the scoped output buffer.
          */
-        ~scoped_output_stream();
+        ~scoped_output_buffer();
 
      private:
         evaluation::context& _context;
@@ -357,11 +357,13 @@ namespace puppet { namespace compiler { namespace evaluation {
         std::shared_ptr<scope> find_scope(std::string const& name) const;
 
         /**
-         * Sets the given capture groups into the context.
+         * Sets the capture groups of a regex match into the context.
+         * The values of the capture groups are created only when they are looked up.
          * Note: This member function has no effect unless a match scope is present.
-         * @param captures The capture groups to set.
+         * @param value The string value that was matched.
+         * @param regions The regions of the match.
          */
-        void set(std::vector<std::string> captures);
+        void set(std::shared_ptr<runtime::values::value const> value, utility::regex::regions const& regions);
 
         /**
          * Looks up a variable's value.
@@ -398,17 +400,17 @@ namespace puppet { namespace compiler { namespace evaluation {
         boost::optional<ast::context> nearest_context() const;
 
         /**
-         * Writes the given value to the output stream.
+         * Writes the given value to the output buffer.
          * @param value The value to write.
-         * @return Returns true if there is a stream to write to or false if not.
+         * @return Returns true if there is a buffer to write to or false if not.
          */
         bool write(runtime::values::value const& value);
 
         /**
-         * Writes the given string data to the output stream.
+         * Writes the given string data to the output buffer.
          * @param ptr The pointer to the string data.
          * @param size The size of the data to write.
-         * @return Returns true if there is a stream to write to or false if not.
+         * @return Returns true if there is a buffer to write to or false if not.
          */
         bool write(char const* ptr, size_t size);
 
@@ -533,14 +535,21 @@ namespace puppet { namespace compiler { namespace evaluation {
         void finalize();
 
      private:
+        struct match_captures
+        {
+            std::shared_ptr<runtime::values::value const> value;
+            std::vector<std::pair<size_t, size_t>> offsets;
+            std::vector<std::shared_ptr<runtime::values::value const>> values;
+        };
+
         friend struct match_scope;
         friend struct node_scope;
-        friend struct scoped_output_stream;
+        friend struct scoped_output_buffer;
         friend struct scoped_stack_frame;
 
         context(context&) = delete;
         context& operator=(context&) = delete;
-        void evaluate_defined_types(size_t& index, std::vector<declared_defined_type*>& virtualized);
+        void evaluate_defined_types(size_t& index, std::vector<size_t>& virtualized, bool realized);
 
         compiler::node* _node;
         compiler::catalog* _catalog;
@@ -551,13 +560,13 @@ namespace puppet { namespace compiler { namespace evaluation {
         std::shared_ptr<scope> _top_scope;
         std::unordered_map<std::string, std::shared_ptr<evaluation::scope>> _named_scopes;
         std::shared_ptr<scope> _node_scope;
-        std::vector<std::shared_ptr<std::vector<std::shared_ptr<runtime::values::value const>>>> _match_stack;
+        std::vector<std::shared_ptr<match_captures>> _match_stack;
         std::unordered_set<std::string> _classes;
         std::vector<declared_defined_type> _defined_types;
         std::unordered_multimap<runtime::types::resource, resource_override, boost::hash<runtime::types::resource>> _overrides;
         std::vector<resource_relationship> _relationships;
         std::vector<std::shared_ptr<collectors::collector>> _collectors;
-        std::vector<std::ostream*> _stream_stack;
+        std::vector<std::string*> _output_stack;
         std::unordered_map<std::string, std::shared_ptr<runtime::values::type>> _resolved_type_aliases;
     };
 
@@ -73,6 +73,15 @@ namespace puppet { namespace compiler { namespace evaluation {
          */
         runtime::values::value evaluate(ast::basic_expression const& expression);
 
+        /**
+         * Matches a case or selector option against a value.
+         * @param option The option to match with.
+         * @param value The value being matched.
+         * @param context The AST context of the option.
+         * @return Returns true if the option matches the value or false if it does not.
+         */
+        bool match(runtime::values::value const& option, runtime::values::value const& value, ast::context const& context);
+
      private:
         template<class> friend class ::boost::detail::variant::invoke_visitor;
         runtime::values::value operator()(ast::basic_expression const& expression);
@@ -9,6 +9,7 @@
 #include "../../runtime/values/value.hpp"
 #include "../../facts/provider.hpp"
 #include <unordered_map>
+#include <vector>
 #include <string>
 #include <memory>
 #include <cstdint>
@@ -142,6 +143,7 @@ namespace puppet { namespace compiler { namespace evaluation {
         compiler::resource* _resource;
         std::unordered_map<std::string, std::pair<std::shared_ptr<runtime::values::value const>, assignment_context>> _variables;
         std::unordered_map<std::string, attributes> _defaults;
+        std::vector<std::shared_ptr<ast::syntax_tree>> _trees;
     };
 
     /**
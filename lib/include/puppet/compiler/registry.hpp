@@ -226,12 +226,18 @@ namespace puppet { namespace compiler {
      private:
         registry(registry&) = delete;
         registry& operator=(registry&) = delete;
+        boost::optional<size_t> find_regex_node(std::string const& name) const;
+        void build_node_matcher() const;
 
         std::unordered_map<std::string, klass> _classes;
         std::unordered_map<std::string, defined_type> _defined_types;
         std::vector<node_definition> _nodes;
         std::unordered_map<std::string, size_t> _named_nodes;
         std::vector<std::pair<runtime::values::regex, size_t>> _regex_nodes;
+        mutable std::unique_ptr<utility::regex> _node_matcher;
+        mutable std::vector<size_t> _node_matcher_indexes;
+        mutable std::vector<bool> _combined_regex_nodes;
+        mutable bool _node_matcher_built = false;
         boost::optional<size_t> _default_node_index;
         std::unordered_map<std::string, type_alias> _aliases;
     };
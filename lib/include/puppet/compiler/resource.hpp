@@ -8,8 +8,7 @@
 #include <string>
 #include <memory>
 #include <functional>
-#include <set>
-#include <unordered_map>
+#include <vector>
 
 namespace puppet { namespace compiler {
 
@@ -23,6 +22,9 @@ namespace puppet { namespace compiler {
     // Forward declaration of catalog.
     struct catalog;
 
+    // Forward declaration of resource_index.
+    struct resource_index;
+
     /**
      * Utility class for tag_set.
      */
@@ -38,9 +40,9 @@ namespace puppet { namespace compiler {
     };
 
     /**
-     * Represents a set of tags (pointers to data stored within each resource).
+     * Represents a set of tags (pointers to tags interned by the catalog, sorted with tag_set_less).
      */
-    using tag_set = std::set<std::string const*, tag_set_less>;
+    using tag_set = std::vector<std::string const*>;
 
     /**
      * Represents a declared resource in a catalog.
@@ -62,7 +64,7 @@ namespace puppet { namespace compiler {
 
         /**
          * Gets the scope where the resource was declared.
-         * @return Returns the scope where the resource was declared.
+         * @return Returns the scope where the resource was declared or nullptr if the catalog has been sealed.
          */
         std::shared_ptr<evaluation::scope> const& scope() const;
 
@@ -119,6 +121,7 @@ namespace puppet { namespace compiler {
 
         /**
          * Enumerates each attribute in the resource.
+         * Attributes are enumerated most recently added first, followed by any resource defaults that apply.
          * @param callback The callback to call for each attribute.
          */
         void each_attribute(std::function<bool(attribute const&)> const& callback) const;
@@ -130,10 +133,18 @@ namespace puppet { namespace compiler {
         void tag(std::string tag);
 
         /**
-         * Calculates the tags for the resource.
+         * Gets the tags for the resource, including the tags of its containers.
+         * The tags are calculated once and only recalculated after tags change.
          * @return Returns the tag set for the resource.
          */
-        tag_set calculate_tags() const;
+        tag_set const& tags() const;
+
+        /**
+         * Determines if the resource has the given tag.
+         * @param tag The tag to check for.
+         * @return Returns true if the resource has the tag or false if not.
+         */
+        bool tagged(std::string const& tag) const;
 
         /**
          * Determines if the given name is a metaparameter name.
@@ -144,22 +155,34 @@ namespace puppet { namespace compiler {
 
      private:
         friend struct catalog;
+        friend struct resource_index;
 
         resource(runtime::types::resource type, resource const* container, std::shared_ptr<evaluation::scope> scope, boost::optional<ast::context> context, bool exported);
         runtime::values::json_value to_json(runtime::values::json_allocator& allocator, compiler::catalog const& catalog) const;
         void add_relationship_parameters(runtime::values::json_value& parameters, runtime::values::json_allocator& allocator, compiler::catalog const& catalog) const;
         void realize(size_t vertex_id);
+        void seal();
         size_t vertex_id() const;
-        void populate_tags(tag_set& tags) const;
+        std::shared_ptr<attribute> const* find_attribute(std::string const& name) const;
+        void retain_tree(ast::syntax_tree* tree);
 
-        std::shared_ptr<ast::syntax_tree> _tree;
+        std::vector<std::shared_ptr<ast::syntax_tree>> _trees;
         runtime::types::resource _type;
         resource const* _container;
         std::shared_ptr<evaluation::scope> _scope;
         boost::optional<ast::context> _context;
+        std::string const* _path;
         size_t _vertex_id;
-        std::unordered_map<std::string, std::shared_ptr<attribute>> _attributes;
-        std::vector<std::string> _tags;
+        size_t _position;
+        resource_index* _index;
+        std::vector<std::shared_ptr<attribute>> _attributes;
+        std::vector<std::string const*> _tags;
+        size_t _tags_version;
+        mutable tag_set _tag_set;
+        mutable size_t _tag_set_version;
+        mutable size_t _computed_tags_version;
+        mutable size_t _computed_container_version;
+        mutable size_t _computed_defaults_generation;
         bool _exported;
     };
 
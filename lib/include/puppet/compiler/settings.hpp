@@ -41,6 +41,10 @@ namespace puppet { namespace compiler {
          * The module path setting.
          */
         static std::string const module_path;
+        /**
+         * The regex timeout setting (the time, in milliseconds, a regular expression match may take).
+         */
+        static std::string const regex_timeout;
 
         /**
          * Constructs the settings using the platform's defaults.
@@ -0,0 +1,56 @@
+/**
+ * @file
+ * Declares the binary facts cache.
+ */
+#pragma once
+
+#include "../runtime/values/value.hpp"
+#include <unordered_map>
+#include <string>
+#include <memory>
+#include <cstdint>
+
+namespace puppet { namespace facts {
+
+    /**
+     * Represents a compact binary cache of converted facts.
+     * The cache is stored alongside a facts file and records the size and modification time of the facts file it was written for.
+     * The cache is only used while the facts file still has the same size and modification time.
+     */
+    struct cache
+    {
+        /**
+         * The type of map the facts are loaded into and saved from.
+         */
+        using fact_map = std::unordered_map<std::string, std::shared_ptr<runtime::values::value const>>;
+
+        /**
+         * Constructs a facts cache for the given facts file.
+         * The size and modification time of the facts file are recorded when the cache is constructed.
+         * @param path The path to the facts file being cached.
+         */
+        explicit cache(std::string path);
+
+        /**
+         * Loads the facts from the cache.
+         * @param facts The map to load the facts into.
+         * @return Returns true if the facts were loaded or false if the cache is missing, stale or invalid.
+         */
+        bool load(fact_map& facts) const;
+
+        /**
+         * Saves the facts to the cache.
+         * Failing to write the cache is not an error; the facts will be converted again on the next load.
+         * @param facts The facts to save.
+         */
+        void save(fact_map const& facts) const;
+
+     private:
+        std::string _path;
+        std::string _cache_path;
+        std::uint64_t _source_size;
+        std::int64_t _source_time;
+        bool _source_valid;
+    };
+
+}}  // puppet::facts
@@ -18,6 +18,8 @@ namespace puppet { namespace facts {
     {
         /**
          * Constructs a new facter fact provider.
+         * The fact collection is initialized on first use; built-in facts are then resolved only when looked up.
+         * External and environment facts can override any fact, so they are all loaded when the collection is initialized.
          */
         facter();
 
@@ -35,10 +37,20 @@ namespace puppet { namespace facts {
          */
         void each(bool accessed, std::function<bool(std::string const&, std::shared_ptr<runtime::values::value const> const&)> const& callback) override;
 
+     protected:
+        /**
+         * Initializes the fact collection when it is first used.
+         * By default, this adds the built-in, external, and environment facts.
+         * @param collection The fact collection to initialize.
+         */
+        virtual void initialize(::facter::facts::collection& collection);
+
      private:
+        ::facter::facts::collection& collection();
         void store(std::string const& name, ::facter::facts::value const* value, runtime::values::value* parent = nullptr);
 
         ::facter::facts::collection _collection;
+        bool _initialized;
         std::unordered_map<std::string, std::shared_ptr<runtime::values::value const>> _cache;
     };
 
@@ -0,0 +1,75 @@
+/**
+ * @file
+ * Declares the JSON fact provider.
+ */
+#pragma once
+
+#include "map_provider.hpp"
+#include <unordered_map>
+#include <string>
+#include <memory>
+#include <functional>
+#include <exception>
+
+namespace puppet { namespace facts {
+
+    /**
+     * Exception for JSON parse errors.
+     */
+    struct json_parse_exception : std::runtime_error
+    {
+        /**
+         * Constructs a JSON parse exception.
+         * @param message The exception message.
+         * @param path The path to the input file.
+         * @param line The line containing the parsing error.
+         * @param column The column containing the parsing error.
+         * @param text The line of text containing the parsing error.
+         */
+        explicit json_parse_exception(std::string const& message, std::string path = std::string(), size_t line = 0, size_t column = 0, std::string text = std::string());
+
+        /**
+         * Gets the path of the input file.
+         * @return Returns the path of the input file.
+         */
+        std::string const& path() const;
+
+        /**
+         * Gets the line of the parsing error.
+         * @return Returns the line of the parsing error.
+         */
+        size_t line() const;
+
+        /**
+         * Gets the column of the parsing error.
+         * @return Returns the column of the parsing error.
+         */
+        size_t column() const;
+
+        /**
+         * Gets the line of text containing the parsing error.
+         * @return Returns the line of text containing the parsing error.
+         */
+        std::string const& text() const;
+
+    private:
+        std::string _path;
+        size_t _line;
+        size_t _column;
+        std::string _text;
+    };
+
+    /**
+     * Represents the JSON fact provider.
+     */
+    struct json : map_provider
+    {
+        /**
+         * Constructs a JSON fact provider with the given path.
+         * @param path The path to the JSON file to load.
+         * @param use_cache True to load the facts from (and save them to) a binary cache next to the file or false to always parse the file.
+         */
+        json(std::string const& path, bool use_cache = false);
+    };
+
+}}  // puppet::facts
@@ -0,0 +1,44 @@
+/**
+ * @file
+ * Declares the base fact provider for facts loaded into memory.
+ */
+#pragma once
+
+#include "provider.hpp"
+#include <unordered_map>
+#include <string>
+#include <memory>
+#include <functional>
+
+namespace puppet { namespace facts {
+
+    /**
+     * Represents the base fact provider for facts that are loaded into memory from a file.
+     */
+    struct map_provider : provider
+    {
+        /**
+         * Looks up a fact value by name.
+         * @param name The name of the fact to look up.
+         * @return Returns the fact's value or nullptr if the fact is not found.
+         */
+        std::shared_ptr<runtime::values::value const> lookup(std::string const& name) override;
+
+        /**
+         * Enumerates the facts in the provider.
+         * @param accessed True to enumerate only the facts which have already been accessed or false to enumerate all facts.
+         * @param callback The callback to call for each fact.
+         */
+        void each(bool accessed, std::function<bool(std::string const&, std::shared_ptr<runtime::values::value const> const&)> const& callback) override;
+
+     protected:
+        /**
+         * Stores the facts loaded by the derived provider.
+         */
+        std::unordered_map<std::string, std::shared_ptr<runtime::values::value const>> _cache;
+
+     private:
+        std::unordered_map<std::string, std::shared_ptr<runtime::values::value const>> _accessed;
+    };
+
+}}  // puppet::facts
@@ -0,0 +1,100 @@
+/**
+ * @file
+ * Declares the shared fact store and the fact provider that views it.
+ */
+#pragma once
+
+#include "provider.hpp"
+#include <unordered_map>
+#include <string>
+#include <memory>
+#include <functional>
+
+namespace puppet { namespace facts {
+
+    /**
+     * Represents a store of immutable fact values shared between nodes.
+     * Values are hash-consed: array elements and hash keys and values are stored as nodes of their own,
+     * so an identical subtree is stored once no matter how many facts or nodes contain it.
+     * Nodes are removed from the store when the last reference to them is released.
+     * The store is safe to use from multiple threads.
+     */
+    struct store
+    {
+        /**
+         * Represents an immutable fact value in the store.
+         */
+        struct node;
+
+        /**
+         * The type of pointer to a node in the store.
+         */
+        using node_pointer = std::shared_ptr<node const>;
+
+        /**
+         * Constructs an empty fact store.
+         */
+        store();
+
+        /**
+         * Interns a fact value.
+         * Values are interned only if identical: strings are compared case sensitively and values of different types are never equal.
+         * @param value The fact value to intern.
+         * @return Returns the node for the value.
+         */
+        node_pointer intern(runtime::values::value const& value);
+
+        /**
+         * Gets the runtime value of a node.
+         * The value is shared with anything else that currently holds the value of the same node.
+         * @param node The node to get the value of.
+         * @return Returns the runtime value of the node.
+         */
+        std::shared_ptr<runtime::values::value const> value(node_pointer const& node) const;
+
+        /**
+         * Gets the number of unique values (including nested values) in the store.
+         * @return Returns the number of unique values in the store.
+         */
+        size_t size() const;
+
+     private:
+        struct index;
+
+        std::shared_ptr<index> _index;
+    };
+
+    /**
+     * Represents a fact provider that exposes a node's facts as a view over a shared fact store.
+     * Only the nodes of the facts are kept; runtime values are created when a fact is first looked up.
+     */
+    struct view : provider
+    {
+        /**
+         * Constructs a view of the given provider's facts.
+         * @param store The shared fact store to intern the facts in.
+         * @param facts The provider of the node's facts.
+         */
+        view(std::shared_ptr<facts::store> store, provider& facts);
+
+        /**
+         * Looks up a fact value by name.
+         * @param name The name of the fact to look up.
+         * @return Returns the fact's value or nullptr if the fact is not found.
+         */
+        std::shared_ptr<runtime::values::value const> lookup(std::string const& name) override;
+
+        /**
+         * Enumerates the facts in the provider.
+         * @param accessed True to enumerate only the facts which have already been accessed or false to enumerate all facts.
+         * @param callback The callback to call for each fact.
+         */
+        void each(bool accessed, std::function<bool(std::string const&, std::shared_ptr<runtime::values::value const> const&)> const& callback) override;
+
+     private:
+        std::shared_ptr<facts::store> _store;
+        std::unordered_map<std::string, store::node_pointer> _facts;
+        std::unordered_map<std::string, std::shared_ptr<runtime::values::value const>> _accessed;
+    };
+
+}}  // puppet::facts
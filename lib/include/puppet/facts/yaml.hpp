@@ -4,7 +4,7 @@
  */
 #pragma once
 
-#include "provider.hpp"
+#include "map_provider.hpp"
 #include <unordered_map>
 #include <string>
 #include <memory>
@@ -69,33 +69,17 @@ namespace puppet { namespace facts {
     /**
      * Represents the YAML fact provider.
      */
-    struct yaml : provider
+    struct yaml : map_provider
     {
         /**
          * Constructs a YAML fact provider with the given path.
          * @param path The path to the YAML file to load.
+         * @param use_cache True to load the facts from (and save them to) a binary cache next to the file or false to always parse the file.
          */
-        yaml(std::string const& path);
-
-        /**
-         * Looks up a fact value by name.
-         * @param name The name of the fact to look up.
-         * @return Returns the fact's value or nullptr if the fact is not found.
-         */
-        std::shared_ptr<runtime::values::value const> lookup(std::string const& name) override;
-
-        /**
-         * Enumerates the facts in the provider.
-         * @param accessed True to enumerate only the facts which have already been accessed or false to enumerate all facts.
-         * @param callback The callback to call for each fact.
-         */
-        void each(bool accessed, std::function<bool(std::string const&, std::shared_ptr<runtime::values::value const> const&)> const& callback) override;
+        yaml(std::string const& path, bool use_cache = false);
 
     private:
         void store(std::string const& name, YAML::Node const& node, runtime::values::value* parent = nullptr);
-
-        std::unordered_map<std::string, std::shared_ptr<runtime::values::value const>> _cache;
-        std::unordered_map<std::string, std::shared_ptr<runtime::values::value const>> _accessed;
     };
 
 }}  // puppet::facts
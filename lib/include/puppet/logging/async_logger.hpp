@@ -0,0 +1,139 @@
+/**
+ * @file
+ * Declares the asynchronous and child loggers.
+ */
+#pragma once
+
+#include "logger.hpp"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <functional>
+
+namespace puppet { namespace logging {
+
+    /**
+     * Implements a logger that queues messages to be written to another logger by a background thread.
+     * Messages are queued into a fixed-size lock-free ring buffer; logging only blocks when the buffer is full.
+     * The logger is safe to use from multiple threads.
+     */
+    struct async_logger : logger
+    {
+        /**
+         * Constructs an asynchronous logger.
+         * @param target The logger to write messages to; only the background thread writes to it.
+         * @param capacity The capacity of the ring buffer (rounded up to a power of two).
+         */
+        explicit async_logger(logger& target, size_t capacity = 4096);
+
+        /**
+         * Destructs the asynchronous logger.
+         * Any queued messages are written before the background thread exits.
+         */
+        ~async_logger();
+
+        /**
+         * Waits until all queued messages have been written.
+         */
+        void flush();
+
+     protected:
+        /**
+         * Logs a message.
+         * @param level The log level.
+         * @param line The line of the source context.
+         * @param column The column of the source context.
+         * @param length The length of the source to highlight.
+         * @param text The context text.
+         * @param path The path of the source file.
+         * @param message The message to log.
+         */
+        void log_message(logging::level level, size_t line, size_t column, size_t length, std::string const& text, std::string const& path, std::string const& message) override;
+
+        /**
+         * Logs a backtrace.
+         * Backtraces refer to evaluation state, so they are written synchronously after the queue has been flushed.
+         * @param backtrace The backtrace to log.
+         */
+        void log_backtrace(std::vector<compiler::evaluation::stack_frame> const& backtrace) override;
+
+     private:
+        struct entry
+        {
+            logging::level level;
+            size_t line;
+            size_t column;
+            size_t length;
+            std::string text;
+            std::string path;
+            std::string message;
+        };
+
+        struct cell
+        {
+            std::atomic<size_t> sequence;
+            entry data;
+        };
+
+        bool try_enqueue(entry& data);
+        bool try_dequeue(entry& data);
+        bool has_message() const;
+        void wake();
+        void wait_for_progress(std::function<bool()> const& done);
+        void run();
+
+        logger& _target;
+        std::mutex _target_mutex;
+        std::unique_ptr<cell[]> _cells;
+        size_t _mask;
+        std::atomic<size_t> _enqueue_position;
+        std::atomic<size_t> _dequeue_position;
+        std::atomic<size_t> _written;
+        std::atomic<bool> _waiting;
+        std::atomic<bool> _stopping;
+        std::atomic<size_t> _blocked;
+        std::mutex _mutex;
+        std::condition_variable _wake;
+        std::condition_variable _progress;
+        std::thread _thread;
+    };
+
+    /**
+     * Implements a logger that forwards messages to a parent logger while keeping its own warning and error counts.
+     * Use a child logger for each compilation that shares a parent logger.
+     */
+    struct child_logger : logger
+    {
+        /**
+         * Constructs a child logger.
+         * The child logger starts with the parent's logging level.
+         * @param parent The parent logger to forward messages to.
+         */
+        explicit child_logger(logger& parent);
+
+     protected:
+        /**
+         * Logs a message.
+         * @param level The log level.
+         * @param line The line of the source context.
+         * @param column The column of the source context.
+         * @param length The length of the source to highlight.
+         * @param text The context text.
+         * @param path The path of the source file.
+         * @param message The message to log.
+         */
+        void log_message(logging::level level, size_t line, size_t column, size_t length, std::string const& text, std::string const& path, std::string const& message) override;
+
+        /**
+         * Logs a backtrace.
+         * @param backtrace The backtrace to log.
+         */
+        void log_backtrace(std::vector<compiler::evaluation::stack_frame> const& backtrace) override;
+
+     private:
+        logger& _parent;
+    };
+
+}}  // namespace puppet::logging
@@ -9,6 +9,7 @@
 #include <string>
 #include <iostream>
 #include <functional>
+#include <atomic>
 
 namespace puppet { namespace logging {
 
@@ -206,15 +207,15 @@ namespace puppet { namespace logging {
         /**
          * Stores the number of warnings encountered.
          */
-        size_t _warnings;
+        std::atomic<size_t> _warnings;
         /**
          * Stores the number of errors encountered.
          */
-        size_t _errors;
+        std::atomic<size_t> _errors;
         /**
          * Stores the minimum logging level.
          */
-        logging::level _level;
+        std::atomic<logging::level> _level;
     };
 
     /**
@@ -297,4 +298,57 @@ namespace puppet { namespace logging {
         bool _colorize_stderr;
     };
 
+    /**
+     * Implements a logger that writes each message as a line of JSON (JSON lines).
+     * Output is buffered and written to the stream in large blocks.
+     */
+    struct json_logger : logger
+    {
+        /**
+         * Constructs a JSON logger.
+         * @param stream The stream to write to.
+         * @param node The name of the node being compiled, included in each message if not empty.
+         */
+        explicit json_logger(std::ostream& stream, std::string node = std::string());
+
+        /**
+         * Destructs the JSON logger.
+         * Any buffered output is written to the stream.
+         */
+        ~json_logger();
+
+        /**
+         * Writes any buffered output to the stream.
+         */
+        void flush();
+
+     protected:
+        /**
+         * Logs a message.
+         * @param level The log level.
+         * @param line The line of the source context.
+         * @param column The column of the source context.
+         * @param length The length of the source to highlight.
+         * @param text The context text.
+         * @param path The path of the source file.
+         * @param message The message to log.
+         */
+        void log_message(logging::level level, size_t line, size_t column, size_t length, std::string const& text, std::string const& path, std::string const& message) override;
+
+        /**
+         * Logs a backtrace.
+         * @param backtrace The backtrace to log.
+         */
+        void log_backtrace(std::vector<compiler::evaluation::stack_frame> const& backtrace) override;
+
+     private:
+        void write_level(logging::level level);
+        void write_string(std::string const& value);
+        void end_line(logging::level level);
+
+        std::ostream& _stream;
+        std::string _node;
+        std::string _buffer;
+    };
+
 }}  // namespace puppet::logger
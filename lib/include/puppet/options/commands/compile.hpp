@@ -6,10 +6,27 @@
 
 #include "parse.hpp"
 #include "../../facts/provider.hpp"
+#include "../../facts/store.hpp"
+#include "../../compiler/catalog.hpp"
 #include <memory>
 
 namespace puppet { namespace options { namespace commands {
 
+    /**
+     * Represents the format of log output.
+     */
+    enum class log_format
+    {
+        /**
+         * Human-readable text.
+         */
+        text,
+        /**
+         * One JSON object per line.
+         */
+        json
+    };
+
     /**
      * Represents the compile command.
      */
@@ -58,13 +75,31 @@ namespace puppet { namespace options { namespace commands {
 
         /**
          * Gets the facts provider from the given options.
+         * Facts loaded from a file are viewed through the command's fact store so that nodes share identical fact values.
          * @param options The options to get the facts provider from.
          * @return Returns the facts provider.
          */
         std::shared_ptr<facts::provider> get_facts(boost::program_options::variables_map const& options) const;
 
+        /**
+         * Gets the catalog output format from the given parsed options.
+         * @param options The parsed options.
+         * @return Returns the catalog output format.
+         */
+        compiler::catalog_format get_format(boost::program_options::variables_map const& options) const;
+
+        /**
+         * Gets the log output format from the given parsed options.
+         * @param options The parsed options.
+         * @return Returns the log output format.
+         */
+        commands::log_format get_log_format(boost::program_options::variables_map const& options) const;
+
         /**
          * Gets the node name from the given parsed options.
+         * Without the node option, the name comes from the first of these facts that is present: the legacy 'fqdn' fact,
+         * the legacy 'hostname' and 'domain' facts, and lastly the structured 'networking' fact.
+         * The legacy facts are checked first because converting the networking fact includes every network interface.
          * @param options The parsed options.
          * @param facts The facts provider to fallback to.
          * @return Returns the node name.
@@ -90,6 +125,22 @@ namespace puppet { namespace options { namespace commands {
          * The facts option description.
          */
         static char const* const FACTS_DESCRIPTION;
+        /**
+         * The facts cache option name.
+         */
+        static char const* const FACTS_CACHE_OPTION;
+        /**
+         * The facts cache option description.
+         */
+        static char const* const FACTS_CACHE_DESCRIPTION;
+        /**
+         * The format option name.
+         */
+        static char const* const FORMAT_OPTION;
+        /**
+         * The format option description.
+         */
+        static char const* const FORMAT_DESCRIPTION;
         /**
          * The graph file option name.
          */
@@ -102,6 +153,14 @@ namespace puppet { namespace options { namespace commands {
          * The graph file option description.
          */
         static char const* const GRAPH_FILE_DESCRIPTION;
+        /**
+         * The log format option name.
+         */
+        static char const* const LOG_FORMAT_OPTION;
+        /**
+         * The log format option description.
+         */
+        static char const* const LOG_FORMAT_DESCRIPTION;
         /**
          * The node option name.
          */
@@ -126,6 +185,9 @@ namespace puppet { namespace options { namespace commands {
          * The trace option description.
          */
         static char const* const TRACE_DESCRIPTION;
+
+     private:
+        std::shared_ptr<facts::store> _facts = std::make_shared<facts::store>();
     };
 
 }}}  // namespace puppet::options::commands
@@ -66,6 +66,7 @@ namespace puppet { namespace runtime { namespace types {
         void write(std::ostream& stream, bool expand = true) const;
 
      private:
+        // Kept ordered: write, iteration, and hash_value depend on a stable member order
         std::set<std::string> _strings;
     };
 
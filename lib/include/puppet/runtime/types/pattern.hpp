@@ -8,6 +8,7 @@
 #include "../values/regex.hpp"
 #include <ostream>
 #include <vector>
+#include <memory>
 
 namespace puppet { namespace runtime { namespace types {
 
@@ -67,7 +68,12 @@ namespace puppet { namespace runtime { namespace types {
         void write(std::ostream& stream, bool expand = true) const;
 
      private:
+        void build_matcher() const;
+
         std::vector<values::regex> _patterns;
+        mutable std::shared_ptr<utility::regex const> _matcher;
+        mutable std::vector<size_t> _uncombined;
+        mutable bool _matcher_built = false;
     };
 
     /**
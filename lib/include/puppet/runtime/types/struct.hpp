@@ -104,7 +104,10 @@ namespace puppet { namespace runtime { namespace types {
         static std::string const& to_key(values::type const& type);
 
      private:
+        void update_keys();
+
         schema_type _schema;
+        std::vector<std::unique_ptr<values::value>> _keys;
     };
 
     /**
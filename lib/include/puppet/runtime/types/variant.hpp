@@ -7,6 +7,7 @@
 #include "../values/forward.hpp"
 #include <ostream>
 #include <vector>
+#include <cstdint>
 
 namespace puppet { namespace runtime { namespace types {
 
@@ -100,7 +101,10 @@ namespace puppet { namespace runtime { namespace types {
         void write(std::ostream& stream, bool expand = true) const;
 
     private:
+        void update_kinds();
+
         std::vector<std::unique_ptr<values::type>> _types;
+        std::vector<std::uint32_t> _kinds;
     };
 
     /**
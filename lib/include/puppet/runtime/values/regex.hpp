@@ -4,6 +4,7 @@
  */
 #pragma once
 
+#include "forward.hpp"
 #include "../../utility/regex.hpp"
 #include <string>
 #include <ostream>
@@ -37,13 +38,26 @@ namespace puppet { namespace runtime { namespace values {
         /**
          * Matches the given string value against the regular expression.
          * If the regular expression matches, match variables are set in the evaluation context.
+         * A variable's value is shared with the match variables rather than copied.
          * @param context The evaluation context.
-         * @param value The string value to match against.
+         * @param value The value to match against; values that are not strings do not match.
          * @return Returns true if the regular expression matched or false if not.
          */
-        bool match(compiler::evaluation::context& context, std::string const& value) const;
+        bool match(compiler::evaluation::context& context, values::value const& value) const;
+
+        /**
+         * Matches the given string value against the regular expression.
+         * If the regular expression matches, match variables are set in the evaluation context.
+         * The value is moved into the match variables rather than copied.
+         * @param context The evaluation context.
+         * @param value The value to match against; values that are not strings do not match.
+         * @return Returns true if the regular expression matched or false if not.
+         */
+        bool match(compiler::evaluation::context& context, values::value&& value) const;
 
     private:
+        bool match_shared(compiler::evaluation::context& context, std::shared_ptr<values::value const> value) const;
+
         std::string _pattern;
     };
 
@@ -0,0 +1,105 @@
+/**
+ * @file
+ * Declares the string runtime value.
+ */
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+namespace puppet { namespace runtime { namespace values {
+
+    /**
+     * Represents a runtime string value.
+     * Metadata about the string is computed the first time it is needed and kept with the string.
+     * Strings held by values are never modified in place; assigning a new string resets the metadata.
+     */
+    struct string_value : std::string
+    {
+        /**
+         * Default constructor for string value.
+         */
+        string_value();
+
+        /**
+         * Constructs a string value from the given string.
+         * @param value The string to copy.
+         */
+        string_value(std::string const& value);
+
+        /**
+         * Constructs a string value from the given string.
+         * @param value The string to move.
+         */
+        string_value(std::string&& value) noexcept;
+
+        /**
+         * Copy constructor for string value.
+         * @param other The other string value to copy; any metadata already computed is copied with it.
+         */
+        string_value(string_value const& other);
+
+        /**
+         * Move constructor for string value.
+         * @param other The other string value to move; any metadata already computed is moved with it.
+         */
+        string_value(string_value&& other) noexcept;
+
+        /**
+         * Copy assignment operator for string value.
+         * @param other The other string value to copy.
+         * @return Returns this string value.
+         */
+        string_value& operator=(string_value const& other);
+
+        /**
+         * Move assignment operator for string value.
+         * @param other The other string value to move.
+         * @return Returns this string value.
+         */
+        string_value& operator=(string_value&& other) noexcept;
+
+        /**
+         * Determines if the string is invariant (i.e. contains only ASCII characters).
+         * @return Returns true if the string is invariant or false if not.
+         */
+        bool invariant() const;
+
+        /**
+         * Gets the number of graphemes in the string.
+         * Throws unicode_exception if the string is not valid UTF-8.
+         * @return Returns the number of graphemes in the string.
+         */
+        size_t graphemes() const;
+
+        /**
+         * Gets the hash of the string (the same as hashing the string as a unicode::string).
+         * Throws unicode_exception if the string is not valid UTF-8.
+         * @return Returns the hash of the string.
+         */
+        size_t hash() const;
+
+        /**
+         * Moves the string out of the value and resets the metadata.
+         * @return Returns the moved string.
+         */
+        std::string release();
+
+     private:
+        void copy_metadata(string_value const& other);
+
+        mutable std::atomic<std::uint8_t> _flags;
+        mutable std::atomic<size_t> _graphemes;
+        mutable std::atomic<size_t> _hash;
+    };
+
+    /**
+     * Hashes a string value.
+     * @param value The string value to hash.
+     * @return Returns the hash value for the string.
+     */
+    size_t hash_value(string_value const& value);
+
+}}}  // namespace puppet::runtime::values
@@ -41,6 +41,7 @@
 #include <boost/optional.hpp>
 #include <boost/mpl/contains.hpp>
 #include <vector>
+#include <cstdint>
 #include <unordered_set>
 #include <exception>
 
@@ -262,6 +263,21 @@ namespace puppet { namespace runtime { namespace values {
          */
         bool is_instance(values::value const& value, types::recursion_guard& guard) const;
 
+        /**
+         * Gets the mask of value kinds that may be instances of this type.
+         * The mask may include kinds that are never instances, but never excludes a kind that may be.
+         * @return Returns the mask of value kinds that may be instances of this type.
+         */
+        std::uint32_t instance_kinds() const;
+
+        /**
+         * Gets the kind of the given value as a mask with a single bit set.
+         * Variable values are dereferenced.
+         * @param value The value to get the kind of.
+         * @return Returns the kind of the given value.
+         */
+        static std::uint32_t kind(values::value const& value);
+
         /**
          * Determines if the given type is assignable to this type.
          * @param other The other type to check for assignability.
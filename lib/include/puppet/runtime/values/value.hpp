@@ -18,6 +18,7 @@
 #include "break_iteration.hpp"
 #include "yield_return.hpp"
 #include "return_value.hpp"
+#include "string_value.hpp"
 #include "../../cast.hpp"
 #include <boost/variant.hpp>
 #include <boost/mpl/contains.hpp>
@@ -66,7 +67,7 @@ namespace puppet { namespace runtime { namespace values {
         std::int64_t,
         double,
         bool,
-        std::string,
+        string_value,
         regex,
         type,
         variable,
@@ -78,6 +79,31 @@ namespace puppet { namespace runtime { namespace values {
         return_value
     >;
 
+    /**
+     * Maps a requested value type to the type stored in the value variant.
+     * @tparam T The requested value type.
+     */
+    template <typename T>
+    struct stored_type
+    {
+        /**
+         * The type stored in the value variant.
+         */
+        using type = T;
+    };
+
+    /**
+     * Maps std::string to the string value type stored in the value variant.
+     */
+    template <>
+    struct stored_type<std::string>
+    {
+        /**
+         * The type stored in the value variant.
+         */
+        using type = string_value;
+    };
+
     /**
      * Represents a runtime value.
      */
@@ -132,6 +158,18 @@ namespace puppet { namespace runtime { namespace values {
          */
         value(values::wrapper<value>&& wrapper);
 
+        /**
+         * Constructs a value given a string.
+         * @param string The string to copy into the value.
+         */
+        value(std::string const& string);
+
+        /**
+         * Constructs a value given a string.
+         * @param string The string to move into the value.
+         */
+        value(std::string&& string) noexcept;
+
         /**
          * Constructs a value given a C string.
          * @param string The string to construct the value with.
@@ -157,6 +195,20 @@ namespace puppet { namespace runtime { namespace values {
          */
         value& operator=(char const* string);
 
+        /**
+         * Copy assignment operator given a string to set as a string value.
+         * @param string The string to assign to the value.
+         * @return Returns this value.
+         */
+        value& operator=(std::string const& string);
+
+        /**
+         * Move assignment operator given a string to set as a string value.
+         * @param string The string to assign to the value.
+         * @return Returns this value.
+         */
+        value& operator=(std::string&& string);
+
         /**
          * Copy assignment operator for value.
          * @tparam T The variant type to assign with.
@@ -211,7 +263,7 @@ namespace puppet { namespace runtime { namespace values {
             if (auto var = boost::get<variable>(this)) {
                 return var->value().as<T>();
             }
-            return boost::get<T>(this);
+            return boost::get<typename stored_type<T>::type>(this);
         }
 
         /**
@@ -243,7 +295,7 @@ namespace puppet { namespace runtime { namespace values {
                 return copy.move_as<T>();
             }
             // Move this value
-            return rvalue_cast(boost::get<T>(*this));
+            return release(boost::get<typename stored_type<T>::type>(*this));
         }
 
         /**
@@ -368,6 +420,18 @@ namespace puppet { namespace runtime { namespace values {
             }
             return value_base::apply_visitor(visitor);
         }
+
+     private:
+        template <typename T>
+        static T release(T& value)
+        {
+            return rvalue_cast(value);
+        }
+
+        static std::string release(string_value& value)
+        {
+            return value.release();
+        }
     };
 
     /**
@@ -378,6 +442,14 @@ namespace puppet { namespace runtime { namespace values {
      */
     std::ostream& operator<<(std::ostream& os, value const& val);
 
+    /**
+     * Appends the string representation of a runtime value to a buffer.
+     * Common scalar values are appended directly without going through an output stream.
+     * @param buffer The buffer to append to.
+     * @param val The runtime value to append.
+     */
+    void append(std::string& buffer, value const& val);
+
     /**
      * Equality operator for value.
      * @param left The left value to compare.
@@ -412,7 +484,7 @@ namespace puppet { namespace runtime { namespace values {
          * @param right The right operand.
          * @return Returns true if the strings are equal (case insensitive) or false if not.
          */
-        result_type operator()(std::string const& left, std::string const& right) const;
+        result_type operator()(string_value const& left, string_value const& right) const;
 
         /**
          * Compares two different value types.
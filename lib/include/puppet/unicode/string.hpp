@@ -151,6 +151,15 @@ namespace puppet { namespace unicode {
         bool _ignore_case = false;
     };
 
+    /**
+     * Gets the length of the leading run of invariant (ASCII) code units in the given UTF-8 data.
+     * The data is scanned with SSE2 or AVX2 instructions when they are available.
+     * @param data The UTF-8 data to scan.
+     * @param length The length of the data, in code units.
+     * @return Returns the number of leading invariant code units (the length if the data is entirely invariant).
+     */
+    size_t invariant_length(char const* data, size_t length) noexcept;
+
     /**
      * A utility type to handle UTF-8 encoded strings.
      * This type can be used to properly handle unnormalized Unicode graphemes.
@@ -185,6 +194,13 @@ namespace puppet { namespace unicode {
          */
         explicit string(std::string const& data);
 
+        /**
+         * Constructs a Unicode string from a UTF-8 encoded std::string that has already been validated.
+         * @param data The string containing the validated UTF-8 encoded data.
+         * @param graphemes The number of graphemes in the string.
+         */
+        string(std::string const& data, size_t graphemes);
+
         /**
          * Constructs a Unicode string from a UTF-8 encoded null terminated C-string.
          * @param data THe string containing the UTF-8 encoded data.
@@ -38,5 +38,14 @@ namespace puppet { namespace utility { namespace filesystem {
      */
     bool normalize_relative_path(std::string& path);
 
+    /**
+     * Reads the entire contents of a file.
+     * The contents are read directly into the string, which is sized from the file's status before reading.
+     * @param path The path to the file to read.
+     * @param contents The string to read the file's contents into.
+     * @return Returns true if the file was read or false if the file could not be read.
+     */
+    bool read_file(std::string const& path, std::string& contents);
+
 
 }}}  // namespace puppet::utility::filesystem
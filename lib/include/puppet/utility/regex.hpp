@@ -9,6 +9,7 @@
 #include <boost/optional.hpp>
 #include <onigmo.h>
 #include <vector>
+#include <chrono>
 #include <string>
 #include <exception>
 #include <memory>
@@ -23,13 +24,13 @@ namespace puppet { namespace utility {
         /**
          * Constructs a regular expression exception.
          * @param message The exception message.
-         * @param code The error code from Onigmo.
+         * @param code The error code from Onigmo or zero if the match timed out.
          */
         regex_exception(std::string const& message, int code);
 
         /**
          * Gets the error code from Onigmo.
-         * @return Returns the error code from Onigmo.
+         * @return Returns the error code from Onigmo or zero if the match timed out.
          */
         int code() const;
 
@@ -146,6 +147,16 @@ namespace puppet { namespace utility {
          */
         bool match(std::string const& str, regex::regions* regions = nullptr) const;
 
+        /**
+         * Matches the regular expression against a shared string.
+         * The match is performed against the entire string.
+         * Unlike matching a string reference, a match with a timeout does not need to copy a shared string.
+         * @param str The shared string to match against the regular expression.
+         * @param regions The regions to populate; if nullptr, no regions are returned.
+         * @return Returns true if the string matched the regular expression or false if it did not.
+         */
+        bool match(std::shared_ptr<std::string const> const& str, regex::regions* regions = nullptr) const;
+
         /**
          * Searches a string for the given regular expression.
          * @param str The string to search.
@@ -155,7 +166,60 @@ namespace puppet { namespace utility {
          */
         bool search(std::string const& str, regex::regions* regions = nullptr, size_t offset = 0) const;
 
+        /**
+         * Searches a shared string for the given regular expression.
+         * Unlike searching a string reference, a search with a timeout does not need to copy a shared string.
+         * @param str The shared string to search.
+         * @param regions The regions to populate; if nullptr, no regions are returned.
+         * @param offset The offset from the start for the search.
+         * @return Returns true if the regular expression was found in the string or false if not.
+         */
+        bool search(std::shared_ptr<std::string const> const& str, regex::regions* regions = nullptr, size_t offset = 0) const;
+
+        /**
+         * Determines if a pattern can be combined with other patterns as an alternative of a single regular expression.
+         * Patterns that refer to their own groups or use extended mode cannot be combined.
+         * @param pattern The pattern to check.
+         * @return Returns true if the pattern can be combined or false if not.
+         */
+        static bool can_combine(std::string const& pattern);
+
+        /**
+         * Limits how long regular expression matches may run on the current thread.
+         * While a scoped timeout is in effect, a match or search that runs longer than the timeout throws a regex_exception.
+         * Timed matches run on a capped set of reused worker threads so that the calling thread can stop waiting.
+         * Onigmo cannot interrupt a match, so a match that exceeds the timeout keeps its worker busy until it completes.
+         */
+        struct scoped_timeout
+        {
+            /**
+             * Constructs a scoped timeout.
+             * @param timeout The timeout for matches on the current thread; zero for no timeout.
+             */
+            explicit scoped_timeout(std::chrono::milliseconds timeout);
+
+            /**
+             * Destructs the scoped timeout and restores the previous timeout.
+             */
+            ~scoped_timeout();
+
+         private:
+            std::chrono::milliseconds _previous;
+        };
+
+        /**
+         * Gets the timeout for matches on the current thread.
+         * @return Returns the timeout for matches on the current thread; zero for no timeout.
+         */
+        static std::chrono::milliseconds timeout();
+
      private:
+        int execute(std::string const& str, std::shared_ptr<std::string const> const& shared, size_t offset, regex::regions* regions, bool search) const;
+        int execute_with_timeout(std::shared_ptr<std::string const> subject, size_t offset, regex::regions* regions, bool search, std::chrono::milliseconds timeout) const;
+        static bool match_result(int result, size_t size, regex::regions* regions);
+        static bool search_result(int result, regex::regions* regions);
+        [[noreturn]] static void throw_match_error(int result);
+
         // The wrapper is used to share the Onigmo regex_t across all copies of this utility::regex
         // This allows for a simple move and copy semantic as we consider the regex_t to be immutable
         struct wrapper
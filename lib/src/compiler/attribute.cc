@@ -1,5 +1,7 @@
 #include <puppet/compiler/attribute.hpp>
 #include <puppet/cast.hpp>
+#include <mutex>
+#include <unordered_set>
 
 using namespace std;
 using namespace puppet::runtime;
@@ -11,25 +13,33 @@ namespace puppet { namespace compiler {
         return left->name() < right->name();
     }
 
-    attribute::attribute(string name, ast::context name_context, shared_ptr<values::value> value, ast::context value_context) :
-        _name(rvalue_cast(name)),
+    // Attribute names come from parameter names, metaparameters and hash keys in manifests
+    // They are interned once for the process and never released so that attributes can refer to them by pointer
+    static string const* intern_name(string const& name)
+    {
+        static mutex lock;
+        static unordered_set<string> names;
+
+        lock_guard<mutex> guard{ lock };
+        auto it = names.find(name);
+        if (it == names.end()) {
+            it = names.emplace(name).first;
+        }
+        return &*it;
+    }
+
+    attribute::attribute(string const& name, ast::context name_context, values::value value, ast::context value_context) :
+        _name(intern_name(name)),
         _name_context(rvalue_cast(name_context)),
         _value(rvalue_cast(value)),
-        _value_context(rvalue_cast(value_context))
+        _value_context(rvalue_cast(value_context)),
+        _shared(false)
     {
-        if (!_value) {
-            throw runtime_error("expected an attribute value.");
-        }
-        if (_name_context.tree) {
-            _tree = _name_context.tree->shared_from_this();
-        } else if (_value_context.tree) {
-            _tree = _value_context.tree->shared_from_this();
-        }
     }
 
     string const& attribute::name() const
     {
-        return _name;
+        return *_name;
     }
 
     ast::context const& attribute::name_context() const
@@ -39,22 +49,25 @@ namespace puppet { namespace compiler {
 
     values::value& attribute::value()
     {
-        return *_value;
+        return _value;
     }
 
     values::value const& attribute::value() const
     {
-        return *_value;
+        return _value;
     }
 
     shared_ptr<values::value> attribute::shared_value()
     {
-        return _value;
+        // The value lives in the attribute, so share it by sharing the attribute
+        _shared = true;
+        return shared_ptr<values::value>(shared_from_this(), &_value);
     }
 
     shared_ptr<values::value const> attribute::shared_value() const
     {
-        return _value;
+        _shared = true;
+        return shared_ptr<values::value const>(shared_from_this(), &_value);
     }
 
     ast::context const& attribute::value_context() const
@@ -62,9 +75,20 @@ namespace puppet { namespace compiler {
         return _value_context;
     }
 
+    ast::syntax_tree* attribute::tree() const
+    {
+        return _name_context.tree ? _name_context.tree : _value_context.tree;
+    }
+
     bool attribute::unique() const
     {
-        return _value.unique();
+        return !_shared;
+    }
+
+    void attribute::release_tree()
+    {
+        _name_context.tree = nullptr;
+        _value_context.tree = nullptr;
     }
 
 }}  // namespace puppet::compiler
@@ -1,11 +1,15 @@
 #include <puppet/compiler/catalog.hpp>
 #include <puppet/compiler/exceptions.hpp>
 #include <puppet/cast.hpp>
-#include <boost/graph/hawick_circuits.hpp>
+#include <boost/graph/strong_components.hpp>
 #include <boost/graph/graphviz.hpp>
+#include <boost/range/iterator_range.hpp>
 #include <boost/format.hpp>
 #include <rapidjson/document.h>
 #include <rapidjson/prettywriter.h>
+#include <rapidjson/writer.h>
+#include <cstring>
+#include <limits>
 
 using namespace std;
 using namespace puppet::runtime;
@@ -49,9 +53,74 @@ namespace puppet { namespace compiler {
     {
     }
 
+    static uint8_t relationship_bit(relationship relation)
+    {
+        return static_cast<uint8_t>(1 << static_cast<int>(relation));
+    }
+
+    static relationship const relationships[] = {
+        relationship::contains,
+        relationship::before,
+        relationship::require,
+        relationship::notify,
+        relationship::subscribe
+    };
+
+    void resource_index::update(compiler::resource const& resource, compiler::attribute const& attribute)
+    {
+        // Only update the index if the attribute is being indexed for the resource's type
+        auto type = _types.find(resource.type().type_name());
+        if (type == _types.end()) {
+            return;
+        }
+        auto values = type->second.find(attribute.name());
+        if (values == type->second.end()) {
+            return;
+        }
+
+        // Positions for the previous value are not removed; the query is still evaluated against every candidate
+        add(values->second, resource._position, attribute.value());
+    }
+
+    void resource_index::add(value_map& values, size_t position, values::value const& value)
+    {
+        values[value].push_back(position);
+
+        // Queries match arrays that contain the value, so also index each element
+        if (auto array = value.as<values::array>()) {
+            for (auto const& element : *array) {
+                values[element].push_back(position);
+            }
+        }
+    }
+
+    string const* resource_index::intern(string const& value)
+    {
+        // Elements of an unordered set are never moved, so the pointer remains valid
+        return &*_strings.insert(value).first;
+    }
+
+    string const* resource_index::intern_path(string const& path)
+    {
+        return &*_paths.insert(path).first;
+    }
+
+    size_t resource_index::tag_defaults_generation() const
+    {
+        return _tag_defaults_generation;
+    }
+
+    void resource_index::invalidate_tag_defaults()
+    {
+        ++_tag_defaults_generation;
+    }
+
     catalog::catalog(string node, string environment) :
         _node(rvalue_cast(node)),
-        _environment(rvalue_cast(environment))
+        _environment(rvalue_cast(environment)),
+        _index(make_shared<resource_index>()),
+        _revision(0),
+        _populated(false)
     {
     }
 
@@ -80,12 +149,16 @@ namespace puppet { namespace compiler {
         _resources.emplace_back(resource(rvalue_cast(type), container, rvalue_cast(scope), rvalue_cast(context), exported));
 
         auto resource = &_resources.back();
+        resource->_index = _index.get();
+        ++_revision;
 
         // Map the type to the resource
         _resource_map[resource->type()] = resource;
 
         // Append to the type list
-        _resource_lists[resource->type().type_name()].emplace_back(resource);
+        auto& list = _resource_lists[resource->type().type_name()];
+        resource->_position = list.size();
+        list.emplace_back(resource);
 
         // Realize the resource if not virtual
         if (!virtualized) {
@@ -115,11 +188,90 @@ namespace puppet { namespace compiler {
         return it->second;
     }
 
+    resource* catalog::find(string const& type, size_t position)
+    {
+        auto it = _resource_lists.find(type);
+        if (it == _resource_lists.end() || position >= it->second.size()) {
+            return nullptr;
+        }
+        return it->second[position];
+    }
+
+    bool catalog::find_candidates(string const& type, string const& name, values::value const& value, size_t offset, vector<size_t>& positions)
+    {
+        positions.clear();
+
+        // Titles can be found directly from the resource map
+        if (name == "title") {
+            if (auto title = value.as<string>()) {
+                auto resource = find(types::resource{ type, *title });
+                if (resource && resource->_position >= offset) {
+                    positions.push_back(resource->_position);
+                }
+            }
+            return true;
+        }
+
+        // A default may give the attribute to any resource, so the resources must be scanned
+        auto defaults = _index->_defaults.find(type);
+        if (defaults != _index->_defaults.end() && defaults->second.count(name)) {
+            return false;
+        }
+
+        auto& attributes = _index->_types[type];
+        auto values = attributes.find(name);
+        if (values == attributes.end()) {
+            // Build the index from the attributes explicitly set on the existing resources
+            values = attributes.emplace(name, resource_index::value_map{}).first;
+            auto list = _resource_lists.find(type);
+            if (list != _resource_lists.end()) {
+                for (auto resource : list->second) {
+                    if (auto attribute = resource->find_attribute(name)) {
+                        resource_index::add(values->second, resource->_position, (*attribute)->value());
+                    }
+                }
+            }
+        }
+
+        auto bucket = values->second.find(value);
+        if (bucket == values->second.end()) {
+            return true;
+        }
+        for (auto position : bucket->second) {
+            if (position >= offset) {
+                positions.push_back(position);
+            }
+        }
+        sort(positions.begin(), positions.end());
+        positions.erase(unique(positions.begin(), positions.end()), positions.end());
+        return true;
+    }
+
+    void catalog::add_default(string const& type, string const& name)
+    {
+        _index->_defaults[type].insert(name);
+
+        if (name == "tag") {
+            _index->invalidate_tag_defaults();
+        }
+    }
+
     size_t catalog::size() const
     {
         return _resources.size();
     }
 
+    size_t catalog::size(string const& type) const
+    {
+        auto it = _resource_lists.find(type);
+        return it == _resource_lists.end() ? 0 : it->second.size();
+    }
+
+    size_t catalog::revision() const
+    {
+        return _revision;
+    }
+
     void catalog::each(function<bool(resource&)> const& callback, string const& type, size_t offset)
     {
         // Adapt the given function so that we cast away const-ness of the resource
@@ -160,11 +312,18 @@ namespace puppet { namespace compiler {
         if (resource.virtualized()) {
             return;
         }
+        if (!_populated) {
+            throw runtime_error("the dependency graph has not been populated.");
+        }
 
         // Get the out edges from this resource
-        for (auto const& edge : make_iterator_range(boost::out_edges(resource.vertex_id(), _graph))) {
-            if (!callback(_graph[edge], *_graph[boost::target(edge, _graph)])) {
-                break;
+        for (auto const& edge : boost::make_iterator_range(boost::out_edges(static_cast<uint32_t>(resource.vertex_id()), _graph))) {
+            auto relations = _graph[edge];
+            auto& target = *_graph[boost::target(edge, _graph)];
+            for (auto relation : relationships) {
+                if ((relations & relationship_bit(relation)) && !callback(relation, target)) {
+                    return;
+                }
             }
         }
     }
@@ -177,6 +336,9 @@ namespace puppet { namespace compiler {
         if (target.virtualized()) {
             throw runtime_error("target cannot be a virtual resource.");
         }
+        if (_populated) {
+            throw runtime_error("cannot add a relationship after the dependency graph has been populated.");
+        }
 
         auto source_ptr = &source;
         auto target_ptr = &target;
@@ -187,13 +349,8 @@ namespace puppet { namespace compiler {
             target_ptr = &source;
         }
 
-        // Add the edge to the graph if it doesn't already exist
-        for (auto const& edge : make_iterator_range(boost::out_edges(source_ptr->vertex_id(), _graph))) {
-            if (_graph[boost::target(edge, _graph)] == target_ptr && _graph[edge] == relation) {
-                return;
-            }
-        }
-        boost::add_edge(source_ptr->vertex_id(), target_ptr->vertex_id(), relation, _graph);
+        // Duplicate edges are merged when the graph is built
+        _edges.push_back({ static_cast<uint32_t>(source_ptr->vertex_id()), static_cast<uint32_t>(target_ptr->vertex_id()), relation });
     }
 
     void catalog::realize(compiler::resource& resource)
@@ -203,7 +360,9 @@ namespace puppet { namespace compiler {
         }
 
         // Realize the resource
-        resource.realize(boost::add_vertex(&resource, _graph));
+        resource.realize(_vertices.size());
+        _vertices.push_back(&resource);
+        ++_revision;
 
         // Add a relationship from container to this resource
         if (resource.container()) {
@@ -232,11 +391,143 @@ namespace puppet { namespace compiler {
             populate_relationships(resource, require_parameter, relationship::require);
             populate_relationships(resource, subscribe_parameter, relationship::subscribe);
         }
+
+        build_graph();
+    }
+
+    void catalog::seal()
+    {
+        if (!_populated) {
+            throw runtime_error("the dependency graph has not been populated.");
+        }
+
+        for (auto& resource : _resources) {
+            resource.seal();
+        }
+
+        // The attribute index is only used by collectors; it is rebuilt on demand if needed
+        _index->_types.clear();
     }
 
-    void catalog::write(ostream& out) const
+    struct msgpack_writer
     {
-        // Declare an adapter for RapidJSON's pretty writter
+        explicit msgpack_writer(ostream& stream) :
+            _stream(stream)
+        {
+        }
+
+        void write(json_value const& value)
+        {
+            if (value.IsNull()) {
+                put(0xc0);
+            } else if (value.IsFalse()) {
+                put(0xc2);
+            } else if (value.IsTrue()) {
+                put(0xc3);
+            } else if (value.IsUint64()) {
+                write_unsigned(value.GetUint64());
+            } else if (value.IsInt64()) {
+                write_signed(value.GetInt64());
+            } else if (value.IsDouble()) {
+                double number = value.GetDouble();
+                uint64_t bits;
+                static_assert(sizeof(bits) == sizeof(number), "expected 64-bit doubles.");
+                memcpy(&bits, &number, sizeof(bits));
+                put(0xcb);
+                put_big_endian(bits, 8);
+            } else if (value.IsString()) {
+                write_header(value.GetStringLength(), 0xa0, 32, 0xd9, 0xda, 0xdb);
+                _stream.write(value.GetString(), value.GetStringLength());
+            } else if (value.IsArray()) {
+                write_header(value.Size(), 0x90, 16, 0, 0xdc, 0xdd);
+                for (auto it = value.Begin(); it != value.End(); ++it) {
+                    write(*it);
+                }
+            } else if (value.IsObject()) {
+                write_header(value.MemberCount(), 0x80, 16, 0, 0xde, 0xdf);
+                for (auto it = value.MemberBegin(); it != value.MemberEnd(); ++it) {
+                    write(it->name);
+                    write(it->value);
+                }
+            } else {
+                throw runtime_error("unexpected JSON value type.");
+            }
+        }
+
+     private:
+        void put(uint8_t byte)
+        {
+            _stream.put(static_cast<char>(byte));
+        }
+
+        void put_big_endian(uint64_t value, size_t bytes)
+        {
+            for (size_t i = bytes; i > 0; --i) {
+                put(static_cast<uint8_t>(value >> ((i - 1) * 8)));
+            }
+        }
+
+        void write_unsigned(uint64_t value)
+        {
+            if (value < 0x80) {
+                put(static_cast<uint8_t>(value));
+            } else if (value <= numeric_limits<uint8_t>::max()) {
+                put(0xcc);
+                put_big_endian(value, 1);
+            } else if (value <= numeric_limits<uint16_t>::max()) {
+                put(0xcd);
+                put_big_endian(value, 2);
+            } else if (value <= numeric_limits<uint32_t>::max()) {
+                put(0xce);
+                put_big_endian(value, 4);
+            } else {
+                put(0xcf);
+                put_big_endian(value, 8);
+            }
+        }
+
+        void write_signed(int64_t value)
+        {
+            // Non-negative values are always handled by write_unsigned
+            if (value >= -32) {
+                put(static_cast<uint8_t>(value));
+            } else if (value >= numeric_limits<int8_t>::min()) {
+                put(0xd0);
+                put_big_endian(static_cast<uint64_t>(value), 1);
+            } else if (value >= numeric_limits<int16_t>::min()) {
+                put(0xd1);
+                put_big_endian(static_cast<uint64_t>(value), 2);
+            } else if (value >= numeric_limits<int32_t>::min()) {
+                put(0xd2);
+                put_big_endian(static_cast<uint64_t>(value), 4);
+            } else {
+                put(0xd3);
+                put_big_endian(static_cast<uint64_t>(value), 8);
+            }
+        }
+
+        void write_header(size_t size, uint8_t fixed, size_t fixed_limit, uint8_t marker8, uint8_t marker16, uint8_t marker32)
+        {
+            if (size < fixed_limit) {
+                put(static_cast<uint8_t>(fixed | size));
+            } else if (marker8 && size <= numeric_limits<uint8_t>::max()) {
+                put(marker8);
+                put_big_endian(size, 1);
+            } else if (size <= numeric_limits<uint16_t>::max()) {
+                put(marker16);
+                put_big_endian(size, 2);
+            } else {
+                put(marker32);
+                put_big_endian(size, 4);
+            }
+        }
+
+        ostream& _stream;
+    };
+
+    void catalog::write(ostream& out, catalog_format format) const
+    {
+        // Declare an adapter for RapidJSON's writers
         struct stream_adapter
         {
             explicit stream_adapter(ostream& stream) : _stream(stream)
@@ -325,10 +616,29 @@ namespace puppet { namespace compiler {
         // Write out the declared classes
         document.AddMember("classes", rvalue_cast(classes), allocator);
 
-        // Write the document to the stream
-        rapidjson::PrettyWriter<stream_adapter> writer{adapter};
-        writer.SetIndent(' ', 2);
-        document.Accept(writer);
+        // Write the document to the stream in the requested format
+        switch (format) {
+            case catalog_format::json: {
+                rapidjson::PrettyWriter<stream_adapter> writer{adapter};
+                writer.SetIndent(' ', 2);
+                document.Accept(writer);
+                break;
+            }
+
+            case catalog_format::compact_json: {
+                rapidjson::Writer<stream_adapter> writer{adapter};
+                document.Accept(writer);
+                break;
+            }
+
+            case catalog_format::msgpack:
+                msgpack_writer{out}.write(document);
+                out.flush();
+                return;
+
+            default:
+                throw runtime_error("unexpected catalog format.");
+        }
 
         // Flush the stream with one last newline
         out << endl;
@@ -340,61 +650,88 @@ namespace puppet { namespace compiler {
 
         // Output the vertices
         for (auto const& vertex : boost::make_iterator_range(boost::vertices(_graph))) {
-            auto resource = _graph[vertex];
-            if (resource->virtualized()) {
-                // Don't write out a vertex unless the resource was realized
-                continue;
-            }
-            out << "  " << vertex << " [label=" << boost::escape_dot_string(boost::lexical_cast<string>(resource->type())) << "];\n";
+            out << "  " << vertex << " [label=" << boost::escape_dot_string(boost::lexical_cast<string>(_graph[vertex]->type())) << "];\n";
         }
         // Output the edges
         for (auto const& edge : boost::make_iterator_range(boost::edges(_graph))) {
             auto source = boost::source(edge, _graph);
             auto target = boost::target(edge, _graph);
-            if (_graph[source]->virtualized() || _graph[target]->virtualized()) {
-                // Don't write out vertices unless source and target are both realized
-                continue;
+            for (auto relation : relationships) {
+                if (_graph[edge] & relationship_bit(relation)) {
+                    out << "  " << source << " -> " << target << " [label=\"" << relation << "\"];\n";
+                }
             }
-            out << "  " << source << " -> " << target << " [label=\"" << _graph[edge] << "\"];\n";
         }
         out << "}\n";
     }
 
-    struct cycle_visitor
+    void catalog::detect_cycles()
     {
-        explicit cycle_visitor(vector<string>& cycles) :
-            _cycles(cycles)
-        {
-        }
+        // Find the strongly connected components of the graph (linear in the number of vertices and edges)
+        // Every cycle in the graph is contained within a single component
+        auto count = boost::num_vertices(_graph);
+        vector<size_t> components(count);
+        auto component_count = boost::strong_components(_graph, boost::make_iterator_property_map(components.begin(), boost::get(boost::vertex_index, _graph)));
+
+        // Report one representative cycle per component, starting from the component's first vertex in declaration order
+        vector<string> cycles;
+        vector<bool> searched(component_count);
+        vector<size_t> predecessors(count, count);
+        vector<size_t> queue;
+        for (size_t root = 0; root < count; ++root) {
+            if (searched[components[root]]) {
+                continue;
+            }
+            searched[components[root]] = true;
+
+            // Perform a breadth-first search within the component for the shortest path back to the root
+            queue.clear();
+            queue.push_back(root);
+            predecessors[root] = root;
+            size_t last = count;
+            for (size_t i = 0; i < queue.size() && last == count; ++i) {
+                auto vertex = queue[i];
+                for (auto const& edge : boost::make_iterator_range(boost::out_edges(static_cast<uint32_t>(vertex), _graph))) {
+                    auto target = boost::target(edge, _graph);
+                    if (components[target] != components[root]) {
+                        continue;
+                    }
+                    if (target == root) {
+                        last = vertex;
+                        break;
+                    }
+                    if (predecessors[target] == count) {
+                        predecessors[target] = vertex;
+                        queue.push_back(target);
+                    }
+                }
+            }
+
+            if (last == count) {
+                // No cycle through the root; the component is a single vertex without a self-edge
+                continue;
+            }
+
+            // Walk the predecessors back to the root to build the path
+            vector<size_t> path;
+            for (auto vertex = last; vertex != root; vertex = predecessors[vertex]) {
+                path.push_back(vertex);
+            }
+            path.push_back(root);
 
-        template <typename Path, typename Graph>
-        void cycle(Path const& path, Graph const& graph)
-        {
             ostringstream cycle;
-            bool first = true;
-            for (auto const& id : path) {
-                if (first) {
-                    first = false;
-                } else {
+            for (auto it = path.rbegin(); it != path.rend(); ++it) {
+                if (it != path.rbegin()) {
                     cycle << " => ";
                 }
-                auto resource = graph[id];
+                auto resource = _graph[*it];
                 cycle << resource->type() << " declared at " << resource->path() << ":" << resource->line();
             }
             // Append on the first vertex again to complete the cycle
-            auto resource = graph[path.front()];
-            cycle << " => " << resource->type();
-            _cycles.push_back(cycle.str());
+            cycle << " => " << _graph[root]->type();
+            cycles.push_back(cycle.str());
         }
 
-        vector<string>& _cycles;
-    };
-
-    void catalog::detect_cycles()
-    {
-        // Check for cycles in the graph
-        vector<string> cycles;
-        boost::hawick_unique_circuits(_graph, cycle_visitor(cycles));
         if (cycles.empty()) {
             return;
         }
@@ -411,6 +748,63 @@ namespace puppet { namespace compiler {
         throw resource_cycle_exception(message.str());
     }
 
+    void catalog::build_graph()
+    {
+        if (_populated) {
+            throw runtime_error("the dependency graph has already been populated.");
+        }
+
+        auto vertex_count = _vertices.size();
+
+        // Stable counting sort of the edges by source so that each resource's edges remain in the order they were added
+        vector<uint32_t> offsets(vertex_count + 1);
+        for (auto const& edge : _edges) {
+            ++offsets[edge.source + 1];
+        }
+        for (size_t i = 1; i < offsets.size(); ++i) {
+            offsets[i] += offsets[i - 1];
+        }
+        vector<pending_edge const*> sorted(_edges.size());
+        {
+            auto positions = offsets;
+            for (auto const& edge : _edges) {
+                sorted[positions[edge.source]++] = &edge;
+            }
+        }
+
+        // Merge edges between the same source and target into a single edge with a relationship bitmask
+        auto const none = numeric_limits<size_t>::max();
+        vector<pair<uint32_t, uint32_t>> edges;
+        vector<uint8_t> relations;
+        vector<size_t> last(vertex_count, none);
+        edges.reserve(_edges.size());
+        relations.reserve(_edges.size());
+        for (size_t source = 0; source < vertex_count; ++source) {
+            auto first = edges.size();
+            for (auto i = offsets[source]; i < offsets[source + 1]; ++i) {
+                auto edge = sorted[i];
+                auto& index = last[edge->target];
+                if (index != none && index >= first) {
+                    relations[index] |= relationship_bit(edge->relationship);
+                    continue;
+                }
+                index = edges.size();
+                edges.emplace_back(edge->source, edge->target);
+                relations.push_back(relationship_bit(edge->relationship));
+            }
+        }
+
+        _graph = decltype(_graph)(boost::edges_are_sorted, edges.begin(), edges.end(), relations.begin(), static_cast<uint32_t>(vertex_count), static_cast<uint32_t>(edges.size()));
+        for (size_t i = 0; i < vertex_count; ++i) {
+            _graph[i] = _vertices[i];
+        }
+
+        // Release the pending state
+        vector<resource*>{}.swap(_vertices);
+        vector<pending_edge>{}.swap(_edges);
+        _populated = true;
+    }
+
     void catalog::populate_relationships(resource const& source, string const& name, compiler::relationship relationship)
     {
         auto attribute = source.get(name);
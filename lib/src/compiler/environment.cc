@@ -5,6 +5,7 @@
 #include <puppet/compiler/exceptions.hpp>
 #include <puppet/logging/logger.hpp>
 #include <puppet/utility/filesystem/helpers.hpp>
+#include <puppet/utility/regex.hpp>
 #include <puppet/cast.hpp>
 #include <boost/algorithm/string.hpp>
 #include <boost/filesystem.hpp>
@@ -19,6 +20,12 @@ namespace po = boost::program_options;
 
 namespace puppet { namespace compiler {
 
+    // The maximum number of inline EPP templates to cache; templates built from dynamic strings would otherwise grow the cache without bound
+    static size_t const max_inline_templates = 1024;
+
+    // The maximum total size of file contents to cache for the file function
+    static uintmax_t const max_cached_file_size = 64 * 1024 * 1024;
+
     static void load_environment_settings(logging::logger& logger, string const& directory, compiler::settings& settings)
     {
         static char const* const CONFIGURATION_FILE = "environment.conf";
@@ -37,7 +44,8 @@ namespace puppet { namespace compiler {
             po::options_description description("");
             description.add_options()
                 (settings::module_path.c_str(), po::value<string>(), "")
-                (settings::manifest.c_str(),    po::value<string>(), "");
+                (settings::manifest.c_str(),    po::value<string>(), "")
+                (settings::regex_timeout.c_str(), po::value<int64_t>(), "");
             po::variables_map vm;
             po::store(po::parse_config_file<char>(config_file_path.c_str(), description, true), vm);
             po::notify(vm);
@@ -52,6 +60,11 @@ namespace puppet { namespace compiler {
                 LOG(debug, "using main manifest '%1%' from environment configuration file.", manifest);
                 settings.set(settings::manifest, rvalue_cast(manifest));
             }
+            if (vm.count(settings::regex_timeout)) {
+                auto timeout = vm[settings::regex_timeout].as<int64_t>();
+                LOG(debug, "using regex timeout of %1% milliseconds from environment configuration file.", timeout);
+                settings.set(settings::regex_timeout, timeout);
+            }
         } catch (po::error const& ex) {
             throw compilation_exception(
                 (boost::format("failed to read environment configuration file '%1%': %2%.") %
@@ -111,8 +124,16 @@ namespace puppet { namespace compiler {
     environment::environment(string name, string directory, compiler::settings settings) :
         finder(rvalue_cast(directory), &settings),
         _name(rvalue_cast(name)),
-        _settings(rvalue_cast(settings))
+        _settings(rvalue_cast(settings)),
+        _regex_timeout(0)
     {
+        auto timeout = _settings.get(settings::regex_timeout, false);
+        if (auto ptr = timeout.as<int64_t>()) {
+            if (*ptr < 0) {
+                throw compilation_exception((boost::format("expected a non-negative integer for $%1% setting.") % settings::regex_timeout).str());
+            }
+            _regex_timeout = chrono::milliseconds(*ptr);
+        }
     }
 
     string const& environment::name() const
@@ -120,6 +141,11 @@ namespace puppet { namespace compiler {
         return _name;
     }
 
+    chrono::milliseconds environment::regex_timeout() const
+    {
+        return _regex_timeout;
+    }
+
     compiler::settings const& environment::settings() const
     {
         return _settings;
@@ -198,7 +224,16 @@ namespace puppet { namespace compiler {
 
         // Find and evaluate a node definition
         if (_registry.has_nodes()) {
-            auto result = _registry.find_node(context.node());
+            pair<node_definition const*, string> result;
+            try {
+                result = _registry.find_node(context.node());
+            } catch (utility::regex_exception const& ex) {
+                throw compiler::compilation_exception(
+                    (boost::format("failed to match node definition regular expression: %1%") %
+                     ex.what()
+                    ).str()
+                );
+            }
             if (!result.first) {
                 ostringstream message;
                 message << "could not find a default node or a node with the following names: ";
@@ -451,4 +486,98 @@ namespace puppet { namespace compiler {
         }
     }
 
+    shared_ptr<ast::syntax_tree> environment::import_template(logging::logger& logger, string const& path)
+    {
+        // If the file's status can't be read, parse without caching and let the parser report the problem
+        // The size is compared along with the modification time as the time only has a resolution of one second
+        sys::error_code ec;
+        auto modified = fs::last_write_time(path, ec);
+        uintmax_t size = 0;
+        if (!ec) {
+            size = fs::file_size(path, ec);
+        }
+        if (!ec) {
+            auto it = _templates.find(path);
+            if (it != _templates.end()) {
+                if (it->second.modified == modified && it->second.size == size) {
+                    LOG(debug, "using cached EPP AST for '%1%' in environment '%2%'.", path, name());
+                    return it->second.tree;
+                }
+                // Remove the stale tree so it can't be mistaken for a later version of the file if parsing fails
+                _templates.erase(it);
+            }
+        }
+
+        auto tree = parser::parse_file(logger, path, nullptr, true);
+        LOG(debug, "parsed EPP AST:\n-----\n%1%\n-----", *tree);
+
+        // Validate as EPP before caching so an invalid template is never reused
+        tree->validate(true);
+
+        if (!ec) {
+            _templates[path] = cached_template{ modified, size, tree };
+        }
+        return tree;
+    }
+
+    shared_ptr<ast::syntax_tree> environment::import_inline_template(logging::logger& logger, string const& source, string const& path)
+    {
+        // Key by the source itself so that identical templates share a tree without risk of hash collisions
+        auto it = _inline_templates.find(source);
+        if (it != _inline_templates.end()) {
+            return it->second;
+        }
+
+        auto tree = parser::parse_string(logger, source, path, nullptr, true);
+        LOG(debug, "parsed inline EPP AST:\n-----\n%1%\n-----", *tree);
+
+        // Validate as EPP before caching so an invalid template is never reused
+        tree->validate(true);
+
+        if (_inline_templates.size() >= max_inline_templates) {
+            _inline_templates.clear();
+        }
+        _inline_templates.emplace(source, tree);
+        return tree;
+    }
+
+    shared_ptr<values::value const> environment::read_file(string const& path)
+    {
+        // If the file's status can't be read, read it without caching
+        sys::error_code ec;
+        auto modified = fs::last_write_time(path, ec);
+        uintmax_t size = 0;
+        if (!ec) {
+            size = fs::file_size(path, ec);
+        }
+        if (!ec) {
+            auto it = _files.find(path);
+            if (it != _files.end()) {
+                if (it->second.modified == modified && it->second.size == size) {
+                    return it->second.contents;
+                }
+                _files_size -= it->second.size;
+                _files.erase(it);
+            }
+        }
+
+        string buffer;
+        if (!utility::filesystem::read_file(path, buffer)) {
+            return nullptr;
+        }
+        // Don't cache files that couldn't be checked for changes or that changed while being read
+        bool cache = !ec && buffer.size() == size && size <= max_cached_file_size;
+        auto contents = make_shared<values::value const>(rvalue_cast(buffer));
+        if (!cache) {
+            return contents;
+        }
+        if (_files_size + size > max_cached_file_size) {
+            _files.clear();
+            _files_size = 0;
+        }
+        _files.emplace(path, cached_file{ modified, size, contents });
+        _files_size += size;
+        return contents;
+    }
+
 }}  // namespace puppet::compiler
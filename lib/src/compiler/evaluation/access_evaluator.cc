@@ -50,7 +50,7 @@ namespace puppet { namespace compiler { namespace evaluation {
             return _transfer;
         }
 
-        value operator()(std::string const& target)
+        value operator()(string_value const& target)
         {
             if (_arguments.size() > 2) {
                 throw evaluation_exception(
@@ -63,8 +63,8 @@ namespace puppet { namespace compiler { namespace evaluation {
                 );
             }
 
-            // Substring using unicode::string
-            unicode::string string{ target };
+            // Substring using unicode::string (only the grapheme count of the target is needed)
+            unicode::string string{ target, target.graphemes() };
 
             // Get the index
             auto ptr = _arguments[0]->as<int64_t>();
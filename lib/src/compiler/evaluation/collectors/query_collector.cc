@@ -24,10 +24,30 @@ namespace puppet { namespace compiler { namespace evaluation { namespace collect
 
         // TODO: support exported resources
 
+        auto& type = _expression.type.name;
+        auto count = catalog.size(type);
+        if (_index >= count) {
+            // No new resources of the type since the last collection
+            return;
+        }
+
         scoped_stack_frame frame{ context, stack_frame{ &_expression, _scope } };
         query_evaluator evaluator{ context, _expression.query };
 
-        // Realize each resource that matches the query
+        // Use the catalog's indexes to find the resources that might match the query
+        vector<size_t> positions;
+        if (evaluator.find_candidates(type, _index, positions)) {
+            for (auto position : positions) {
+                auto resource = catalog.find(type, position);
+                if (resource && evaluator.evaluate(*resource)) {
+                    collect_resource(context, *resource, false);
+                }
+            }
+            _index = count;
+            return;
+        }
+
+        // Otherwise, realize each resource that matches the query
         catalog.each(
             [&](compiler::resource& resource) {
                 ++_index;
@@ -38,7 +58,7 @@ namespace puppet { namespace compiler { namespace evaluation { namespace collect
                 }
                 return true;
             },
-            _expression.type.name,
+            type,
             _index
         );
     }
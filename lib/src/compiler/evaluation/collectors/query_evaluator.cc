@@ -1,7 +1,10 @@
 #include <puppet/compiler/evaluation/collectors/query_evaluator.hpp>
 #include <puppet/compiler/evaluation/evaluator.hpp>
 #include <puppet/compiler/evaluation/context.hpp>
+#include <puppet/cast.hpp>
 #include <boost/format.hpp>
+#include <algorithm>
+#include <iterator>
 
 using namespace std;
 using namespace puppet::runtime;
@@ -27,21 +30,31 @@ namespace puppet { namespace compiler { namespace evaluation { namespace collect
         return climb_expression(_expression->operand, 0, begin, _expression->operations.end(), resource);
     }
 
+    values::value const& query_evaluator::expected_value(ast::attribute_query const& query) const
+    {
+        // Evaluate each query's value once; it is used for finding candidates and for every resource evaluated
+        auto it = _expected.find(&query);
+        if (it == _expected.end()) {
+            evaluation::evaluator evaluator{ _context };
+            it = _expected.emplace(&query, evaluator.evaluate(query.value)).first;
+        }
+        return it->second;
+    }
+
     bool query_evaluator::evaluate(ast::basic_query_expression const& expression, compiler::resource const& resource) const
     {
         // Handle nested expressions
         if (auto nested = boost::get<x3::forward_ast<ast::nested_query_expression>>(&expression)) {
-            query_evaluator evaluator{ _context, nested->get().expression };
-            return evaluator.evaluate(resource);
+            auto& nested_expression = nested->get().expression;
+            auto begin = nested_expression.operations.begin();
+            return climb_expression(nested_expression.operand, 0, begin, nested_expression.operations.end(), resource);
         }
 
-        evaluation::evaluator evaluator{ _context };
-
         // Otherwise, this should be an attribute query
         auto& query = boost::get<ast::attribute_query>(expression);
 
-        // Evaluate the expected value
-        auto expected = evaluator.evaluate(query.value);
+        // Get the expected value
+        auto& expected = expected_value(query);
 
         // If the query is on the title, search the resource's title
         bool result = false;
@@ -107,6 +120,88 @@ namespace puppet { namespace compiler { namespace evaluation { namespace collect
         return result;
     }
 
+    bool query_evaluator::find_candidates(string const& type, size_t offset, vector<size_t>& positions) const
+    {
+        // A query is required to find candidates
+        if (!_expression) {
+            return false;
+        }
+
+        auto begin = _expression->operations.begin();
+        auto result = climb_candidates(_expression->operand, 0, begin, _expression->operations.end(), type, offset);
+        if (!result) {
+            return false;
+        }
+        positions = rvalue_cast(*result);
+        return true;
+    }
+
+    query_evaluator::candidates query_evaluator::find_candidates(ast::basic_query_expression const& expression, string const& type, size_t offset) const
+    {
+        // Handle nested expressions
+        if (auto nested = boost::get<x3::forward_ast<ast::nested_query_expression>>(&expression)) {
+            auto& nested_expression = nested->get().expression;
+            auto begin = nested_expression.operations.begin();
+            return climb_candidates(nested_expression.operand, 0, begin, nested_expression.operations.end(), type, offset);
+        }
+
+        // Only equality can be looked up
+        auto& query = boost::get<ast::attribute_query>(expression);
+        if (query.operator_ != ast::query_operator::equals) {
+            return boost::none;
+        }
+
+        vector<size_t> positions;
+        if (!_context.catalog().find_candidates(type, query.attribute.value, expected_value(query), offset, positions)) {
+            return boost::none;
+        }
+        return positions;
+    }
+
+    query_evaluator::candidates query_evaluator::climb_candidates(
+        ast::basic_query_expression const& expression,
+        std::uint8_t min_precedence,
+        std::vector<ast::binary_query_operation>::const_iterator& begin,
+        std::vector<ast::binary_query_operation>::const_iterator const& end,
+        string const& type,
+        size_t offset) const
+    {
+        // Find the candidates of the left-hand side of the expression
+        auto result = find_candidates(expression, type, offset);
+
+        // Climb the binary operations based on operator precedence (there is no short circuiting for candidates)
+        uint8_t precedence;
+        while (begin != end && (precedence = get_precedence(begin->operator_)) >= min_precedence)
+        {
+            auto& operation = *begin;
+            ++begin;
+
+            uint8_t next_precedence = precedence + (is_right_associative(operation.operator_) ? static_cast<uint8_t>(0) : static_cast<uint8_t>(1));
+            auto right = climb_candidates(operation.operand, next_precedence, begin, end, type, offset);
+
+            if (operation.operator_ == ast::binary_query_operator::logical_and) {
+                // Either side's candidates are sufficient for "and", so use the intersection if both sides have candidates
+                if (!result) {
+                    result = rvalue_cast(right);
+                } else if (right) {
+                    vector<size_t> intersection;
+                    set_intersection(result->begin(), result->end(), right->begin(), right->end(), back_inserter(intersection));
+                    result = rvalue_cast(intersection);
+                }
+            } else {
+                // Both sides need candidates for "or"
+                if (!result || !right) {
+                    result = boost::none;
+                } else {
+                    vector<size_t> combined;
+                    set_union(result->begin(), result->end(), right->begin(), right->end(), back_inserter(combined));
+                    result = rvalue_cast(combined);
+                }
+            }
+        }
+        return result;
+    }
+
     uint8_t query_evaluator::get_precedence(ast::binary_query_operator op)
     {
         // Return the precedence (low to high)
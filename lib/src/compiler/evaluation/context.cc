@@ -35,15 +35,15 @@ namespace puppet { namespace compiler { namespace evaluation {
         _context._node_scope.reset();
     }
 
-    scoped_output_stream::scoped_output_stream(evaluation::context& context, ostream& stream) :
+    scoped_output_buffer::scoped_output_buffer(evaluation::context& context, string& buffer) :
         _context(context)
     {
-        _context._stream_stack.push_back(&stream);
+        _context._output_stack.push_back(&buffer);
     }
 
-    scoped_output_stream::~scoped_output_stream()
+    scoped_output_buffer::~scoped_output_buffer()
     {
-        _context._stream_stack.pop_back();
+        _context._output_stack.pop_back();
     }
 
     resource_relationship::resource_relationship(
@@ -420,7 +420,7 @@ namespace puppet { namespace compiler { namespace evaluation {
         return it->second;
     }
 
-    void context::set(vector<string> captures)
+    void context::set(shared_ptr<values::value const> value, utility::regex::regions const& regions)
     {
         if (_match_stack.empty()) {
             return;
@@ -430,15 +430,17 @@ namespace puppet { namespace compiler { namespace evaluation {
 
         // If there is no scope or a closure has captured the match scope, reset
         if (!scope || !scope.unique()) {
-            scope = make_shared<vector<shared_ptr<values::value const>>>();
+            scope = make_shared<match_captures>();
         }
 
-        scope->clear();
-        scope->reserve(captures.size());
-
-        for (auto& capture : captures) {
-            scope->emplace_back(make_shared<values::value const>(rvalue_cast(capture)));
+        // Only record the offsets of the captures; the values are created when looked up
+        scope->value = rvalue_cast(value);
+        scope->offsets.clear();
+        scope->offsets.reserve(regions.count());
+        for (size_t i = 0; i < regions.count(); ++i) {
+            scope->offsets.emplace_back(regions.begin(i), regions.end(i));
         }
+        scope->values.assign(regions.count(), nullptr);
     }
 
     shared_ptr<values::value const> context::lookup(ast::variable const& expression, bool warn)
@@ -482,10 +484,21 @@ namespace puppet { namespace compiler { namespace evaluation {
         for (auto it = _match_stack.rbegin(); it != _match_stack.rend(); ++it) {
             auto const& matches = *it;
             if (matches) {
-                if (index >= matches->size()) {
+                if (index >= matches->offsets.size()) {
                     return nullptr;
                 }
-                return (*matches)[index];
+                auto& value = matches->values[index];
+                if (!value) {
+                    // Unmatched capture groups are empty strings
+                    auto& string = *matches->value->as<std::string>();
+                    auto& offsets = matches->offsets[index];
+                    if (offsets.first >= string.size() || offsets.second > string.size()) {
+                        value = make_shared<values::value const>(std::string{});
+                    } else {
+                        value = make_shared<values::value const>(string.substr(offsets.first, offsets.second - offsets.first));
+                    }
+                }
+                return value;
             }
         }
         return nullptr;
@@ -515,19 +528,19 @@ namespace puppet { namespace compiler { namespace evaluation {
 
     bool context::write(values::value const& value)
     {
-        if (_stream_stack.empty()) {
+        if (_output_stack.empty()) {
             return false;
         }
-        *_stream_stack.back() << value;
+        values::append(*_output_stack.back(), value);
         return true;
     }
 
     bool context::write(char const* ptr, size_t size)
     {
-        if (_stream_stack.empty()) {
+        if (_output_stack.empty()) {
             return false;
         }
-        _stream_stack.back()->write(ptr, size);
+        _output_stack.back()->append(ptr, size);
         return true;
     }
 
@@ -831,24 +844,38 @@ namespace puppet { namespace compiler { namespace evaluation {
         size_t iteration = 0;
         size_t index = 0;
 
-        // Keep track of a list of defined types that are virtual
-        vector<declared_defined_type*> virtualized;
+        // The number of collectors that have run and the catalog revision when they last ran
+        size_t collected = 0;
+        size_t collected_revision = numeric_limits<size_t>::max();
+
+        // The catalog revision when the virtual defined types were last checked for realization
+        size_t realized_revision = numeric_limits<size_t>::max();
+
+        // Keep track of a list of defined types (indexes into the list of defined types) that are virtual
+        vector<size_t> virtualized;
         while (true) {
-            // Run all collectors
-            for (auto& collector : _collectors) {
-                collector->collect(*this);
+            // Run the collectors only if resources were added or realized since they last ran; new collectors always run
+            auto count = _collectors.size();
+            for (size_t i = (collected_revision == catalog.revision() ? collected : 0); i < count; ++i) {
+                _collectors[i]->collect(*this);
             }
-
-            // After collection, if all defined types have been evaluated and the elements of the virtualized list are
-            // still virtual, then there is nothing left to do
-            if (index >= _defined_types.size() && std::all_of(virtualized.begin(), virtualized.end(), [](auto const& element) {
-                return element->resource().virtualized();
-            })) {
+            collected = count;
+            collected_revision = catalog.revision();
+
+            // Only check the virtual defined types if resources were realized since they were last checked
+            bool realized = !virtualized.empty() && realized_revision != catalog.revision();
+            realized_revision = catalog.revision();
+
+            // After collection, if all defined types have been evaluated and no virtual defined type may have been realized,
+            // then there is nothing left to do
+            if (index >= _defined_types.size() && (!realized || std::all_of(virtualized.begin(), virtualized.end(), [&](auto element) {
+                return _defined_types[element].resource().virtualized();
+            }))) {
                 break;
             }
 
             // Evaluate the defined types
-            evaluate_defined_types(index, virtualized);
+            evaluate_defined_types(index, virtualized, realized);
 
             // Guard against infinite recursion by limiting the number of loop iterations
             if (iteration++ >= max_iterations) {
@@ -881,38 +908,35 @@ namespace puppet { namespace compiler { namespace evaluation {
         _overrides.clear();
     }
 
-    void context::evaluate_defined_types(size_t& index, vector<declared_defined_type*>& virtualized)
+    void context::evaluate_defined_types(size_t& index, vector<size_t>& virtualized, bool realized)
     {
-        resource const* current = nullptr;
-
-        // Evaluate any previously virtual defined type
-        virtualized.erase(remove_if(virtualized.begin(), virtualized.end(), [&](auto const& declared) {
-            // Check to see if the resource is still virtual
-            if (declared->resource().virtualized()) {
-                return false;
-            }
-            // Evaluate the defined type
-            current = &declared->resource();
-            defined_type_evaluator evaluator{ *this, declared->definition().statement() };
-            evaluator.evaluate(declared->resource());
-            return true;
-        }), virtualized.end());
+        // Evaluate any previously virtual defined type that has since been realized
+        // Note: indexes are stored because evaluation may declare more defined types, growing the list
+        if (realized) {
+            virtualized.erase(remove_if(virtualized.begin(), virtualized.end(), [&](auto element) {
+                // Check to see if the resource is still virtual
+                if (_defined_types[element].resource().virtualized()) {
+                    return false;
+                }
+                // Evaluate the defined type
+                defined_type_evaluator evaluator{ *this, _defined_types[element].definition().statement() };
+                evaluator.evaluate(_defined_types[element].resource());
+                return true;
+            }), virtualized.end());
+        }
 
         // Evaluate all non-virtual define types from the current start to the current end *only*
         // Any defined types that are added to the list as a result of the evaluation will be themselves
-        // evaluated on the next pass.
+        // evaluated on the next pass (after the collectors have had a chance to collect them).
         auto size = _defined_types.size();
         for (; index < size; ++index) {
-            auto& declared = _defined_types[index];
-
-            if (declared.resource().virtualized()) {
+            if (_defined_types[index].resource().virtualized()) {
                 // Defined type is virtual, enqueue it for later evaluation
-                virtualized.emplace_back(&declared);
+                virtualized.emplace_back(index);
                 continue;
             }
-            current = &declared.resource();
-            defined_type_evaluator evaluator{ *this, declared.definition().statement() };
-            evaluator.evaluate(declared.resource());
+            defined_type_evaluator evaluator{ *this, _defined_types[index].definition().statement() };
+            evaluator.evaluate(_defined_types[index].resource());
         }
     }
 
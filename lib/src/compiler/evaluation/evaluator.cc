@@ -104,6 +104,21 @@ namespace puppet { namespace compiler { namespace evaluation {
         return operator()(expression);
     }
 
+    bool evaluator::match(value const& option, value const& value, ast::context const& context)
+    {
+        try {
+            return option.match(_context, value);
+        } catch (utility::regex_exception const& ex) {
+            throw evaluation_exception(
+                (boost::format("failed to match regular expression: %1%") %
+                 ex.what()
+                ).str(),
+                context,
+                _context.backtrace()
+            );
+        }
+    }
+
     value evaluator::operator()(basic_expression const& expression)
     {
         return boost::apply_visitor(*this, expression);
@@ -222,29 +237,37 @@ namespace puppet { namespace compiler { namespace evaluation {
 
     value evaluator::operator()(interpolated_string const& expression)
     {
-        ostringstream os;
-        scoped_output_stream output{ _context, os };
+        // Build the string directly rather than through an output stream
+        // Reserve space for the literal text; the interpolated values grow the string as needed
+        std::string result;
+        size_t length = 0;
+        for (auto const& part : expression.parts) {
+            if (auto ptr = boost::get<literal_string_text>(&part)) {
+                length += ptr->text.size();
+            }
+        }
+        result.reserve(length);
 
         size_t current_margin = expression.margin;
 
         for (auto const& part : expression.parts) {
             if (auto ptr = boost::get<literal_string_text>(&part)) {
-                align_text(ptr->text, expression.margin, current_margin, [this](char const* ptr, size_t size) {
-                    _context.write(ptr, size);
+                align_text(ptr->text, expression.margin, current_margin, [&](char const* ptr, size_t size) {
+                    result.append(ptr, size);
                 });
             } else if (auto ptr = boost::get<ast::variable>(&part)) {
                 current_margin = 0;
-                _context.write(operator()(*ptr));
+                values::append(result, operator()(*ptr));
             } else if (auto ptr = boost::get<x3::forward_ast<ast::expression>>(&part)) {
                 current_margin = 0;
                 auto value = evaluate(*ptr);
                 value.ensure();
-                _context.write(value);
+                values::append(result, value);
             } else {
                 throw evaluation_exception("unsupported interpolation part.", part.context(), _context.backtrace());
             }
         }
-        return os.str();
+        return result;
     }
 
     value evaluator::operator()(ast::array const& expression)
@@ -318,7 +341,7 @@ namespace puppet { namespace compiler { namespace evaluation {
                 }
 
                 // Match the option value
-                if (option_value.match(_context, result)) {
+                if (match(option_value, result, option.context())) {
                     return evaluate(proposition.body);
                 }
 
@@ -326,7 +349,7 @@ namespace puppet { namespace compiler { namespace evaluation {
                 if (option.is_splat() && option_value.as<values::array>()) {
                     auto array = option_value.move_as<values::array>();
                     for (auto& element : array) {
-                        if (element->match(_context, result)) {
+                        if (match(*element, result, option.context())) {
                             return evaluate(proposition.body);
                         }
                     }
@@ -449,7 +472,7 @@ namespace puppet { namespace compiler { namespace evaluation {
 
     value evaluator::operator()(epp_render_string const& expression)
     {
-        if (!_context.write(expression.string)) {
+        if (!_context.write(expression.string.data(), expression.string.size())) {
             throw evaluation_exception("EPP expressions are not supported.", expression, _context.backtrace());
         }
         return values::undef();
@@ -915,7 +938,7 @@ namespace puppet { namespace compiler { namespace evaluation {
             attributes.emplace_back(make_pair(operation.operator_, std::make_shared<attribute>(
                 name,
                 operation.name,
-                std::make_shared<values::value>(rvalue_cast(value)),
+                rvalue_cast(value),
                 operation.value.context()
             )));
         }
@@ -973,7 +996,7 @@ namespace puppet { namespace compiler { namespace evaluation {
             attributes.emplace_back(make_pair(operation.operator_, std::make_shared<compiler::attribute>(
                 *name,
                 operation.name,
-                std::make_shared<values::value>(rvalue_cast(value)),
+                rvalue_cast(value),
                 rvalue_cast(context)
             )));
         }
@@ -1034,7 +1057,21 @@ namespace puppet { namespace compiler { namespace evaluation {
 
         // Validate the type of the parameter
         types::recursion_guard guard;
-        if (type && !type->is_instance(value, guard)) {
+        bool instance = true;
+        try {
+            instance = !type || type->is_instance(value, guard);
+        } catch (utility::regex_exception const& ex) {
+            throw evaluation_exception(
+                (boost::format("attribute '%1%' could not be checked against type %2%: %3%") %
+                 name %
+                 *type %
+                 ex.what()
+                ).str(),
+                context,
+                _context.backtrace()
+            );
+        }
+        if (!instance) {
             throw evaluation_exception(
                 (boost::format("expected %1% for attribute '%2%' but found %3%.") %
                  *type %
@@ -1272,7 +1309,13 @@ namespace puppet { namespace compiler { namespace evaluation {
             );
         }
         types::recursion_guard guard;
-        if (!type->is_instance(value, guard)) {
+        bool instance = false;
+        try {
+            instance = type->is_instance(value, guard);
+        } catch (utility::regex_exception const& ex) {
+            error((boost::format("parameter $%1% could not be checked against type %2%: %3%") % parameter.variable.name % *type % ex.what()).str());
+        }
+        if (!instance) {
             error((boost::format("parameter $%1% has expected type %2% but was given %3%.") % parameter.variable.name % *type % value.infer_type()).str());
         }
     }
@@ -1577,16 +1620,17 @@ namespace puppet { namespace compiler { namespace evaluation {
                 }
 
                 // Evaluate the default value expression
-                value = std::make_shared<values::value>(evaluate_default_value(_context, *parameter.default_value));
                 context = parameter.default_value->context();
-
-                // Set the parameter as an attribute on the resource
-                resource.set(std::make_shared<compiler::attribute>(
+                auto default_attribute = std::make_shared<compiler::attribute>(
                     name,
                     parameter.variable,
-                    value,
+                    evaluate_default_value(_context, *parameter.default_value),
                     context
-                ));
+                );
+
+                // Set the parameter as an attribute on the resource and share its value with the scope
+                value = default_attribute->shared_value();
+                resource.set(rvalue_cast(default_attribute));
             }
 
             // Verify the value matches the parameter type
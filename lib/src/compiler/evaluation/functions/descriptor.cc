@@ -2,6 +2,7 @@
 #include <puppet/compiler/evaluation/functions/call_context.hpp>
 #include <puppet/compiler/evaluation/evaluator.hpp>
 #include <puppet/compiler/exceptions.hpp>
+#include <puppet/utility/regex.hpp>
 #include <boost/format.hpp>
 
 using namespace std;
@@ -95,17 +96,32 @@ namespace puppet { namespace compiler { namespace evaluation { namespace functio
 
         // Search for a dispatch descriptor with a matching signature
         // TODO: in the future, this should dispatch to the most specific overload rather than the first dispatchable overload
-        for (auto& descriptor : _dispatch_descriptors) {
-            if (descriptor.signature.can_dispatch(context)) {
-                scoped_stack_frame frame{
-                    evaluation_context,
-                    stack_frame{
-                        _name.c_str(),
-                        make_shared<evaluation::scope>(evaluation_context.top_scope())
-                    }
-                };
-                return descriptor.callback(context);
+        try {
+            for (auto& descriptor : _dispatch_descriptors) {
+                if (descriptor.signature.can_dispatch(context)) {
+                    scoped_stack_frame frame{
+                        evaluation_context,
+                        stack_frame{
+                            _name.c_str(),
+                            make_shared<evaluation::scope>(evaluation_context.top_scope())
+                        }
+                    };
+                    return descriptor.callback(context);
+                }
+            }
+        } catch (utility::regex_exception const& ex) {
+            // Only a timed out match (code 0) is rewrapped; other regex errors keep their original message
+            if (ex.code() != 0) {
+                throw;
             }
+            throw evaluation_exception(
+                (boost::format("function '%1%' failed to match regular expression: %2%") %
+                 _name %
+                 ex.what()
+                ).str(),
+                context.name(),
+                evaluation_context.backtrace()
+            );
         }
 
         // Find the reason the call could not be dispatched
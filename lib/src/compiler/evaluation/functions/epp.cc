@@ -5,6 +5,7 @@
 #include <puppet/compiler/parser/parser.hpp>
 #include <puppet/compiler/evaluation/evaluator.hpp>
 #include <puppet/compiler/exceptions.hpp>
+#include <puppet/cast.hpp>
 #include <boost/format.hpp>
 
 using namespace std;
@@ -36,21 +37,17 @@ namespace puppet { namespace compiler { namespace evaluation { namespace functio
         }
 
         try {
-            // Parse the EPP template
-            auto tree = parser::parse_file(logger, path, nullptr, true);
-            LOG(debug, "parsed EPP AST:\n-----\n%1%\n-----", *tree);
+            // Get the parsed and validated EPP template from the environment
+            auto tree = environment.import_template(logger, path);
 
-            // Validate as EPP
-            tree->validate(true);
-
-            // Create a local output stream
-            ostringstream os;
-            scoped_output_stream epp_stream{ context.context(), os };
+            // Create a local output buffer; the rendered result is moved out of it without a copy
+            std::string output;
+            scoped_output_buffer epp_output{ context.context(), output };
 
             // Evaluate the syntax tree
             evaluation::evaluator evaluator{ context.context() };
             evaluator.evaluate(*tree, &arguments);
-            return os.str();
+            return rvalue_cast(output);
         } catch (parse_exception const& ex) {
             // Log the underlying problem and then throw an error pointing at the argument
             ifstream input{ path };
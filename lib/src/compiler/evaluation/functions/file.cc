@@ -2,8 +2,6 @@
 #include <puppet/compiler/evaluation/functions/call_context.hpp>
 #include <puppet/compiler/exceptions.hpp>
 #include <boost/format.hpp>
-#include <fstream>
-#include <sstream>
 
 using namespace std;
 using namespace puppet::runtime;
@@ -24,8 +22,8 @@ namespace puppet { namespace compiler { namespace evaluation { namespace functio
                 if (path.empty()) {
                     continue;
                 }
-                ifstream stream{ path };
-                if (!stream) {
+                auto contents = environment.read_file(path);
+                if (!contents) {
                     throw evaluation_exception(
                         (boost::format("could not open file '%1%' for reading.") %
                          path
@@ -34,9 +32,8 @@ namespace puppet { namespace compiler { namespace evaluation { namespace functio
                         context.context().backtrace()
                     );
                 }
-                ostringstream output;
-                output << stream.rdbuf();
-                return output.str();
+                // Treat the contents as a variable so the cached contents are shared rather than copied
+                return values::variable(rvalue_cast(path), rvalue_cast(contents));
             }
             throw evaluation_exception(
                 "could not find any of the specified files.",
@@ -4,6 +4,7 @@
 #include <puppet/compiler/parser/parser.hpp>
 #include <puppet/compiler/evaluation/evaluator.hpp>
 #include <puppet/compiler/exceptions.hpp>
+#include <puppet/cast.hpp>
 #include <boost/format.hpp>
 
 using namespace std;
@@ -26,21 +27,18 @@ namespace puppet { namespace compiler { namespace evaluation { namespace functio
         static auto path = "<epp>";
 
         try {
-            // Parse the string as an EPP template
-            auto tree = parser::parse_string(logger, input, path, nullptr, true);
-            LOG(debug, "parsed inline EPP AST:\n-----\n%1%\n-----", *tree);
+            // Get the parsed and validated EPP template from the environment
+            auto tree = evaluation_context.node().environment().import_inline_template(logger, input, path);
 
-            // Validate as EPP
-            tree->validate(true);
-
-            // Create a local output stream
-            ostringstream os;
-            scoped_output_stream epp_stream{ evaluation_context, os };
+            // Create a local output buffer; the rendered result is moved out of it without a copy
+            std::string output;
+            output.reserve(tree->source().size());
+            scoped_output_buffer epp_output{ evaluation_context, output };
 
             // Evaluate the syntax tree
             evaluation::evaluator evaluator{ evaluation_context };
             evaluator.evaluate(*tree, &arguments);
-            return os.str();
+            return rvalue_cast(output);
         } catch (parse_exception const& ex) {
             // Log the underlying problem and then throw an error pointing at the argument
             auto info = lexer::get_line_info(input, ex.begin().offset(), ex.end().offset() - ex.begin().offset());
@@ -24,15 +24,13 @@ namespace puppet { namespace compiler { namespace evaluation { namespace functio
                 return false;
             }
 
-            auto tags = resource->calculate_tags();
-
             // Make sure all given arguments are in the tag set
             auto& arguments = context.arguments();
             for (size_t i = 0; i < arguments.size(); ++i) {
                 auto& argument = context.argument(i);
                 bool matches = true;
                 if (!argument.move_as<string>([&](string tag) {
-                    if (tags.find(&tag) == tags.end()) {
+                    if (!resource->tagged(tag)) {
                         matches = false;
                         return false;
                     }
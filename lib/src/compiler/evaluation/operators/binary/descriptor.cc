@@ -1,6 +1,7 @@
 #include <puppet/compiler/evaluation/operators/binary/descriptor.hpp>
 #include <puppet/compiler/evaluation/operators/binary/call_context.hpp>
 #include <puppet/compiler/exceptions.hpp>
+#include <puppet/utility/regex.hpp>
 #include <boost/format.hpp>
 
 using namespace std;
@@ -48,10 +49,25 @@ namespace puppet { namespace compiler { namespace evaluation { namespace operato
         // Search for a dispatch descriptor with the matching left and right types
         // TODO: in the future, this should dispatch to the most specific overload rather than the first dispatchable overload
         types::recursion_guard guard;
-        for (auto& descriptor : _dispatch_descriptors) {
-            if (descriptor.left_type.is_instance(context.left(), guard) && descriptor.right_type.is_instance(context.right(), guard)) {
-                return descriptor.callback(context);
+        try {
+            for (auto& descriptor : _dispatch_descriptors) {
+                if (descriptor.left_type.is_instance(context.left(), guard) && descriptor.right_type.is_instance(context.right(), guard)) {
+                    return descriptor.callback(context);
+                }
             }
+        } catch (utility::regex_exception const& ex) {
+            // Only a timed out match (code 0) is rewrapped; other regex errors keep their original message
+            if (ex.code() != 0) {
+                throw;
+            }
+            throw evaluation_exception(
+                (boost::format("binary operator '%1%' failed to match regular expression: %2%") %
+                 _operator %
+                 ex.what()
+                ).str(),
+                context.operator_context(),
+                context.context().backtrace()
+            );
         }
 
         // Check to see if the LHS or RHS had at least one matching type; if so, build a set of expected types for the other side
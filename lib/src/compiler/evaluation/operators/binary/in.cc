@@ -18,7 +18,7 @@ namespace puppet { namespace compiler { namespace evaluation { namespace operato
             return static_cast<bool>(unicode::string{ right }.find(left, true));
         });
         descriptor.add("Regexp", "String", [](call_context& context) {
-            return context.left().require<values::regex>().match(context.context(), context.right().require<string>());
+            return context.left().require<values::regex>().match(context.context(), rvalue_cast(context.right()));
         });
         descriptor.add("Type", "Array[Any]", [](call_context& context) {
             auto& left = context.left().require<values::type>();
@@ -35,8 +35,7 @@ namespace puppet { namespace compiler { namespace evaluation { namespace operato
             auto& left = context.left().require<values::regex>();
             auto& right = context.right().require<values::array>();
             for (auto const& element : right) {
-                auto ptr = element->as<string>();
-                if (ptr && left.match(context.context(), *ptr)) {
+                if (left.match(context.context(), *element)) {
                     return true;
                 }
             }
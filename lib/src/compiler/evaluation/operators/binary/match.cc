@@ -8,10 +8,27 @@ using namespace puppet::runtime;
 
 namespace puppet { namespace compiler { namespace evaluation { namespace operators { namespace binary {
 
-    bool is_match(call_context& context, string const& left, string const& right)
+    bool is_match(call_context& context, values::value&& left, values::regex const& right)
     {
         try {
-            return values::regex{ right }.match(context.context(), left);
+            return right.match(context.context(), rvalue_cast(left));
+        } catch (utility::regex_exception const& ex) {
+            throw evaluation_exception(
+                (boost::format("failed to match regular expression %1%: %2%") %
+                 right %
+                 ex.what()
+                ).str(),
+                context.right_context(),
+                context.context().backtrace()
+            );
+        }
+    }
+
+    bool is_match(call_context& context, values::value&& left, string const& right)
+    {
+        boost::optional<values::regex> regex;
+        try {
+            regex.emplace(right);
         } catch (utility::regex_exception const& ex) {
             throw evaluation_exception(
                 (boost::format("invalid regular expression: %1%") %
@@ -21,6 +38,7 @@ namespace puppet { namespace compiler { namespace evaluation { namespace operato
                 context.context().backtrace()
             );
         }
+        return is_match(context, rvalue_cast(left), *regex);
     }
 
     descriptor match::create_descriptor()
@@ -28,10 +46,10 @@ namespace puppet { namespace compiler { namespace evaluation { namespace operato
         binary::descriptor descriptor{ ast::binary_operator::match };
 
         descriptor.add("String", "String", [](call_context& context) {
-            return is_match(context, context.left().require<string>(), context.right().require<string>());
+            return is_match(context, rvalue_cast(context.left()), context.right().require<string>());
         });
         descriptor.add("String", "Regexp", [](call_context& context) {
-            return context.right().require<values::regex>().match(context.context(), context.left().require<string>());
+            return is_match(context, rvalue_cast(context.left()), context.right().require<values::regex>());
         });
         descriptor.add("Any", "Type", [](call_context& context) {
             types::recursion_guard guard;
@@ -6,18 +6,19 @@ using namespace puppet::runtime;
 
 namespace puppet { namespace compiler { namespace evaluation { namespace operators { namespace binary {
 
-    // Forward declare the implementation (defined in match.cc)
-    bool is_match(call_context& context, string const& left, string const& right);
+    // Forward declare the implementations (defined in match.cc)
+    bool is_match(call_context& context, values::value&& left, values::regex const& right);
+    bool is_match(call_context& context, values::value&& left, string const& right);
 
     descriptor not_match::create_descriptor()
     {
         binary::descriptor descriptor{ ast::binary_operator::not_match };
 
         descriptor.add("String", "String", [](call_context& context) {
-            return !is_match(context, context.left().require<string>(), context.right().require<string>());
+            return !is_match(context, rvalue_cast(context.left()), context.right().require<string>());
         });
         descriptor.add("String", "Regexp", [](call_context& context) {
-            return !context.right().require<values::regex>().match(context.context(), context.left().require<string>());
+            return !is_match(context, rvalue_cast(context.left()), context.right().require<values::regex>());
         });
         descriptor.add("Any", "Type", [](call_context& context) {
             types::recursion_guard guard;
@@ -53,7 +53,7 @@ namespace puppet { namespace compiler { namespace evaluation {
                     continue;
                 }
 
-                if (selector.match(_evaluator.context(), _value)) {
+                if (_evaluator.match(selector, _value, selector_case.first.context())) {
                     _value = _evaluator.evaluate(selector_case.second);
                     _value_context.end = selector_case.second.context().end;
                     return;
@@ -63,7 +63,7 @@ namespace puppet { namespace compiler { namespace evaluation {
                 if (selector_case.first.is_splat()) {
                     auto unfolded = selector.to_array();
                     for (auto& element : unfolded) {
-                        if (element->match(_evaluator.context(), _value)) {
+                        if (_evaluator.match(*element, _value, selector_case.first.context())) {
                             _value = _evaluator.evaluate(selector_case.second);
                             _value_context.end = selector_case.second.context().end;
                             return;
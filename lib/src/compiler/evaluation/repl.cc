@@ -4,6 +4,7 @@
 #include <puppet/compiler/scanner.hpp>
 #include <puppet/compiler/evaluation/evaluator.hpp>
 #include <puppet/compiler/exceptions.hpp>
+#include <puppet/utility/regex.hpp>
 #include <boost/format.hpp>
 
 using namespace std;
@@ -151,6 +152,11 @@ namespace puppet { namespace compiler { namespace evaluation {
             if (_error_handler) {
                 _error_handler(ex);
             }
+        } catch (utility::regex_exception const& ex) {
+            // Matches are converted to evaluation exceptions where there is a context; this handles any others
+            if (_error_handler) {
+                _error_handler(compilation_exception{ (boost::format("failed to match regular expression: %1%") % ex.what()).str() });
+            }
         }
         return boost::none;
     }
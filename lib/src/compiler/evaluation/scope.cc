@@ -3,6 +3,7 @@
 #include <puppet/compiler/exceptions.hpp>
 #include <puppet/cast.hpp>
 #include <boost/algorithm/string.hpp>
+#include <algorithm>
 
 using namespace std;
 using namespace puppet::runtime;
@@ -123,6 +124,20 @@ namespace puppet { namespace compiler { namespace evaluation {
 
     void scope::add_defaults(evaluation::context& context, types::resource const& type, compiler::attributes attributes)
     {
+        // Defaulted attributes cannot be found using the catalog's attribute index
+        for (auto& attribute : attributes) {
+            context.catalog().add_default(type.type_name(), attribute.second->name());
+        }
+
+        // Attributes do not keep their syntax tree alive, so keep the tree of the defaults expression while the scope has them
+        if (!attributes.empty()) {
+            if (auto tree = attributes.front().second->tree()) {
+                if (find_if(_trees.begin(), _trees.end(), [&](auto const& retained) { return retained.get() == tree; }) == _trees.end()) {
+                    _trees.emplace_back(tree->shared_from_this());
+                }
+            }
+        }
+
         auto it = _defaults.find(type.type_name());
         if (it != _defaults.end()) {
             // The defaults already exist, so ensure there are no conflicts at this scope
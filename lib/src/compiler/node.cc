@@ -1,6 +1,7 @@
 #include <puppet/compiler/node.hpp>
 #include <puppet/compiler/exceptions.hpp>
 #include <puppet/compiler/evaluation/context.hpp>
+#include <puppet/utility/regex.hpp>
 #include <puppet/cast.hpp>
 #include <boost/algorithm/string.hpp>
 
@@ -55,6 +56,9 @@ namespace puppet { namespace compiler {
 
     catalog node::compile(vector<string> const& manifests)
     {
+        // Bound regular expression matches for the duration of the compilation
+        utility::regex::scoped_timeout timeout{ _environment->regex_timeout() };
+
         try {
             // Create the catalog and evaluation context
             compiler::catalog catalog{ name(), _environment->name() };
@@ -72,9 +76,15 @@ namespace puppet { namespace compiler {
 
             // Populate relationship metaparameters to the graph
             catalog.populate_graph();
+
+            // Release the evaluation state now that the catalog is complete
+            catalog.seal();
             return catalog;
         } catch (evaluation_exception const& ex) {
             throw compilation_exception(ex);
+        } catch (utility::regex_exception const& ex) {
+            // Matches are converted to evaluation exceptions where there is a context; this handles any others
+            throw compilation_exception((boost::format("failed to match regular expression: %1%") % ex.what()).str());
         }
     }
 
@@ -30,6 +30,7 @@ namespace puppet { namespace compiler {
         set(environment_path, "$codedir/environments");
         set(manifest, "manifests");
         set(module_path, "modules:$basemodulepath");
+        set(regex_timeout, static_cast<int64_t>(0));
     }
 
 }}  // namespace puppet::options
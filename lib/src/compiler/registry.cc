@@ -3,6 +3,7 @@
 #include <puppet/compiler/node.hpp>
 #include <puppet/cast.hpp>
 #include <boost/algorithm/string.hpp>
+#include <boost/format.hpp>
 
 using namespace std;
 using namespace puppet::runtime;
@@ -114,13 +115,12 @@ namespace puppet { namespace compiler {
                 definition = &_nodes[it->second];
                 return false;
             }
-            // Next, check by looking at every regex
-            for (auto const& kvp : _regex_nodes) {
-                if (kvp.first.search(name)) {
-                    node_name = "/" + kvp.first.pattern() + "/";
-                    definition = &_nodes[kvp.second];
-                    return false;
-                }
+            // Next, check the regexes
+            if (auto index = find_regex_node(name)) {
+                auto const& kvp = _regex_nodes[*index];
+                node_name = "/" + kvp.first.pattern() + "/";
+                definition = &_nodes[kvp.second];
+                return false;
             }
             return true;
         });
@@ -217,9 +217,100 @@ namespace puppet { namespace compiler {
         {
             _regex_nodes.emplace_back(rvalue_cast(regex), node_index);
         }
+        if (!regexes.empty()) {
+            _node_matcher_built = false;
+        }
         return nullptr;
     }
 
+    void registry::build_node_matcher() const
+    {
+        _node_matcher.reset();
+        _node_matcher_indexes.clear();
+        _combined_regex_nodes.assign(_regex_nodes.size(), false);
+        _node_matcher_built = true;
+
+        // Combine the patterns into alternatives of a single regex, each in a named group
+        // With named groups present, the patterns' unnamed groups do not capture, so group N identifies the Nth alternative
+        string expression;
+        for (size_t i = 0; i < _regex_nodes.size(); ++i) {
+            auto const& pattern = _regex_nodes[i].first.pattern();
+            if (!utility::regex::can_combine(pattern)) {
+                continue;
+            }
+            if (!expression.empty()) {
+                expression += '|';
+            }
+            expression += (boost::format("(?<n%1%>") % i).str();
+            expression += pattern;
+            expression += ')';
+            _node_matcher_indexes.push_back(i);
+        }
+        if (_node_matcher_indexes.size() < 2) {
+            _node_matcher_indexes.clear();
+            return;
+        }
+
+        try {
+            _node_matcher.reset(new utility::regex(expression));
+        } catch (utility::regex_exception const&) {
+            // Fall back to searching with each regex
+            _node_matcher_indexes.clear();
+            return;
+        }
+        for (auto index : _node_matcher_indexes) {
+            _combined_regex_nodes[index] = true;
+        }
+    }
+
+    boost::optional<size_t> registry::find_regex_node(string const& name) const
+    {
+        if (!_node_matcher_built) {
+            build_node_matcher();
+        }
+
+        // The combined matcher finds the first alternative that matches at the leftmost position
+        // A lower alternative may still match further into the name, so search again after each match start
+        size_t limit = _regex_nodes.size();
+        bool matched = false;
+        if (_node_matcher) {
+            utility::regex::regions regions;
+            size_t offset = 0;
+            while (offset <= name.size() && _node_matcher->search(name, &regions, offset)) {
+                for (size_t group = 1; group < regions.count(); ++group) {
+                    if (regions.begin(group) != numeric_limits<size_t>::max()) {
+                        limit = min(limit, _node_matcher_indexes[group - 1]);
+                        matched = true;
+                        break;
+                    }
+                }
+                if (limit == _node_matcher_indexes.front()) {
+                    break;
+                }
+
+                // Move to the start of the next character after the match start
+                offset = regions.begin(0) + 1;
+                while (offset < name.size() && (static_cast<unsigned char>(name[offset]) & 0xC0) == 0x80) {
+                    ++offset;
+                }
+            }
+        }
+
+        // Regexes that could not be combined are searched individually, but only those before the combined match
+        for (size_t i = 0; i < limit; ++i) {
+            if (_combined_regex_nodes[i]) {
+                continue;
+            }
+            if (_regex_nodes[i].first.search(name)) {
+                return i;
+            }
+        }
+        if (matched) {
+            return limit;
+        }
+        return boost::none;
+    }
+
     bool registry::has_nodes() const
     {
         return !_nodes.empty();
@@ -42,6 +42,9 @@ namespace puppet { namespace compiler {
     string const& resource::path() const
     {
         static string main = "<main>";
+        if (_path) {
+            return *_path;
+        }
         if (!_context || !_context->tree) {
             return main;
         }
@@ -50,7 +53,7 @@ namespace puppet { namespace compiler {
 
     size_t resource::line() const
     {
-        if (!_context || !_context->tree) {
+        if (!_context || (!_context->tree && !_path)) {
             return 0;
         }
         return _context->begin.line();
@@ -68,11 +71,11 @@ namespace puppet { namespace compiler {
 
     shared_ptr<attribute> resource::get(string const& name) const
     {
-        auto it = _attributes.find(name);
-        if (it == _attributes.end()) {
+        auto attribute = find_attribute(name);
+        if (!attribute) {
             return _scope ? _scope->find_default(_type, name) : nullptr;
         }
-        return it->second;
+        return *attribute;
     }
 
     void resource::set(shared_ptr<compiler::attribute> attribute)
@@ -81,7 +84,26 @@ namespace puppet { namespace compiler {
             return;
         }
 
-        _attributes[attribute->name()] = rvalue_cast(attribute);
+        if (_index) {
+            _index->update(*this, *attribute);
+        }
+
+        // The tag metaparameter contributes to the tags of the resource and everything it contains
+        if (attribute->name() == "tag") {
+            ++_tags_version;
+        }
+
+        // Keep the attribute's syntax tree alive for as long as the resource refers to it
+        retain_tree(attribute->tree());
+
+        // Replace any existing attribute of the same name in place; names are interned, so compare them by address
+        for (auto& existing : _attributes) {
+            if (&existing->name() == &attribute->name()) {
+                existing = rvalue_cast(attribute);
+                return;
+            }
+        }
+        _attributes.emplace_back(rvalue_cast(attribute));
     }
 
     bool resource::append(shared_ptr<compiler::attribute> attribute)
@@ -126,13 +148,13 @@ namespace puppet { namespace compiler {
             return;
         }
 
+        // Attribute names are unique, so the set is only needed to exclude defaults that were explicitly set
+        // The most recently added attributes are enumerated first
         attribute_set set;
-        for (auto const& kvp : _attributes) {
-            if (!set.insert(kvp.second.get()).second) {
-                continue;
-            }
-            if (!callback(*kvp.second)) {
-                break;
+        for (auto it = _attributes.rbegin(); it != _attributes.rend(); ++it) {
+            set.insert(it->get());
+            if (!callback(**it)) {
+                return;
             }
         }
 
@@ -144,14 +166,59 @@ namespace puppet { namespace compiler {
     void resource::tag(string tag)
     {
         boost::to_lower(tag);
-        _tags.emplace_back(rvalue_cast(tag));
+        _tags.push_back(_index->intern(tag));
+        ++_tags_version;
+    }
+
+    tag_set const& resource::tags() const
+    {
+        // The calculated tags are current if this resource's tags, the container's calculated tags, and the tag defaults are unchanged
+        // Changes to a container reach the resources it contains through the container's tag set version
+        tag_set const* container_tags = _container ? &_container->tags() : nullptr;
+        size_t container_version = _container ? _container->_tag_set_version : 0;
+        size_t defaults_generation = _index->tag_defaults_generation();
+        if (_computed_tags_version == _tags_version &&
+            _computed_container_version == container_version &&
+            _computed_defaults_generation == defaults_generation) {
+            return _tag_set;
+        }
+
+        // Start with the tags of the resource and those in the tag metaparameter
+        tag_set tags{ _tags.begin(), _tags.end() };
+        auto attribute = get("tag");
+        if (attribute) {
+            if (auto array = attribute->value().as<values::array>()) {
+                for (auto const& element : *array) {
+                    if (auto tag = element->as<string>()) {
+                        tags.push_back(_index->intern(*tag));
+                    }
+                }
+            }
+        }
+        sort(tags.begin(), tags.end(), tag_set_less());
+
+        // Interned tags are equal only if they are the same pointer
+        tags.erase(unique(tags.begin(), tags.end()), tags.end());
+
+        // Merge in the container's tags (calculated once for the container and shared by all the resources it contains)
+        if (container_tags) {
+            _tag_set.clear();
+            _tag_set.reserve(tags.size() + container_tags->size());
+            set_union(tags.begin(), tags.end(), container_tags->begin(), container_tags->end(), back_inserter(_tag_set), tag_set_less());
+        } else {
+            _tag_set = rvalue_cast(tags);
+        }
+        _computed_tags_version = _tags_version;
+        _computed_container_version = container_version;
+        _computed_defaults_generation = defaults_generation;
+        ++_tag_set_version;
+        return _tag_set;
     }
 
-    tag_set resource::calculate_tags() const
+    bool resource::tagged(string const& tag) const
     {
-        tag_set tags;
-        populate_tags(tags);
-        return tags;
+        auto& tags = this->tags();
+        return binary_search(tags.begin(), tags.end(), &tag, tag_set_less());
     }
 
     bool resource::is_metaparameter(string const& name)
@@ -177,14 +244,22 @@ namespace puppet { namespace compiler {
         _container(container),
         _scope(rvalue_cast(scope)),
         _context(rvalue_cast(context)),
+        _path(nullptr),
         _vertex_id(numeric_limits<size_t>::max()),
+        _position(0),
+        _index(nullptr),
+        _tags_version(0),
+        _tag_set_version(0),
+        _computed_tags_version(numeric_limits<size_t>::max()),
+        _computed_container_version(numeric_limits<size_t>::max()),
+        _computed_defaults_generation(numeric_limits<size_t>::max()),
         _exported(exported)
     {
         if (_container && _type.is_stage()) {
             throw runtime_error("stages cannot have a container.");
         }
-        if (_context && _context->tree) {
-            _tree = _context->tree->shared_from_this();
+        if (_context) {
+            retain_tree(_context->tree);
         }
     }
 
@@ -201,10 +276,11 @@ namespace puppet { namespace compiler {
         value.AddMember("title", rapidjson::StringRef(title.c_str(), title.size()), allocator);
 
         // Write out the tags
-        auto tags = calculate_tags();
+        auto& tags = this->tags();
         json_value tags_array;
         tags_array.SetArray();
-        for (auto& tag : tags) {
+        tags_array.Reserve(tags.size(), allocator);
+        for (auto tag : tags) {
             tags_array.PushBack(json_value(rapidjson::StringRef(tag->c_str()), tag->size()), allocator);
         }
         value.AddMember("tags", rvalue_cast(tags_array), allocator);
@@ -301,7 +377,7 @@ namespace puppet { namespace compiler {
 
         // Perform auto tagging
         if (is_class) {
-            _tags.emplace_back("class");
+            _tags.push_back(_index->intern("class"));
         }
 
         auto name = boost::to_lower_copy(is_class ? _type.title() : _type.type_name());
@@ -311,14 +387,48 @@ namespace puppet { namespace compiler {
             if (!*it) {
                 continue;
             }
-            _tags.emplace_back(it->begin(), it->end());
+            _tags.push_back(_index->intern(string{ it->begin(), it->end() }));
             ++parts;
         }
 
         // If the name had more than one part, add the entire name too (otherwise it was already added)
         if (parts > 1) {
-            _tags.emplace_back(rvalue_cast(name));
+            _tags.push_back(_index->intern(name));
         }
+        ++_tags_version;
+    }
+
+    void resource::seal()
+    {
+        // Copy the defaults from the scope so that the scope can be released
+        // The defaults are enumerated after the explicitly set attributes, so insert them in reverse at the front
+        if (_scope) {
+            attribute_set set;
+            for (auto const& attribute : _attributes) {
+                set.insert(attribute.get());
+            }
+            vector<shared_ptr<attribute>> defaults;
+            _scope->each_default(_type, set, [&](attribute const& attribute) {
+                defaults.emplace_back(_scope->find_default(_type, attribute.name()));
+                return true;
+            });
+            _attributes.insert(_attributes.begin(), defaults.rbegin(), defaults.rend());
+        }
+
+        // Keep only the path of the syntax tree
+        if (_context && _context->tree) {
+            _path = _index->intern_path(_context->tree->path());
+            _context->tree = nullptr;
+        }
+
+        // Release the syntax trees referenced by the attributes
+        for (auto& attribute : _attributes) {
+            attribute->release_tree();
+        }
+
+        _scope.reset();
+        _trees.clear();
+        _trees.shrink_to_fit();
     }
 
     size_t resource::vertex_id() const
@@ -326,31 +436,29 @@ namespace puppet { namespace compiler {
         return _vertex_id;
     }
 
-    void resource::populate_tags(tag_set& tags) const
+    shared_ptr<attribute> const* resource::find_attribute(string const& name) const
     {
-        // First add what is in the tags list
-        for (auto const& tag : _tags) {
-            tags.insert(&tag);
-        }
-
-        // Next add what is in the tag metaparameter
-        auto attribute = get("tag");
-        if (attribute) {
-            if (auto array = attribute->value().as<values::array>()) {
-                for (auto const& element : *array) {
-                    if (auto tag = element->as<string>()) {
-                        tags.insert(tag);
-                    }
-                }
+        // Resources have few attributes, so a linear search of the flat list is faster than hashing the name
+        for (auto const& attribute : _attributes) {
+            if (attribute->name() == name) {
+                return &attribute;
             }
         }
+        return nullptr;
+    }
 
-        // If there's a container, add its tags
-        // REVISIT: it would be far more efficient not to have to duplicate these at every resource, but that
-        //          requires catalog format improvements
-        if (_container) {
-            _container->populate_tags(tags);
+    void resource::retain_tree(ast::syntax_tree* tree)
+    {
+        if (!tree) {
+            return;
+        }
+        // Attributes of a resource nearly always come from the resource's own tree, so the list is short
+        for (auto const& retained : _trees) {
+            if (retained.get() == tree) {
+                return;
+            }
         }
+        _trees.emplace_back(tree->shared_from_this());
     }
 
 }}  // namespace puppet::compiler
@@ -17,6 +17,7 @@ namespace puppet { namespace compiler {
     string const settings::environment_path = "environmentpath";
     string const settings::manifest = "manifest";
     string const settings::module_path = "modulepath";
+    string const settings::regex_timeout = "regextimeout";
 
     void settings::set(string const& name, values::value value)
     {
@@ -0,0 +1,327 @@
+#include <puppet/facts/cache.hpp>
+#include <puppet/cast.hpp>
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <sstream>
+#include <cstring>
+
+using namespace std;
+using namespace puppet::runtime;
+namespace fs = boost::filesystem;
+namespace sys = boost::system;
+
+namespace puppet { namespace facts {
+
+    // The cache file starts with a magic string that includes the format version
+    static char const cache_magic[] = "puppetcpp-facts\x02";
+    static size_t const cache_magic_size = sizeof(cache_magic) - 1;
+
+    enum class cache_tag : uint8_t
+    {
+        undef,
+        false_,
+        true_,
+        integer,
+        floating,
+        string,
+        array,
+        hash
+    };
+
+    struct cache_writer
+    {
+        explicit cache_writer(ostream& stream) :
+            _stream(stream)
+        {
+        }
+
+        void write(string const& value)
+        {
+            write_size(value.size());
+            _stream.write(value.data(), value.size());
+        }
+
+        void write(values::value const& value)
+        {
+            if (value.is_undef()) {
+                write_tag(cache_tag::undef);
+            } else if (auto ptr = value.as<bool>()) {
+                write_tag(*ptr ? cache_tag::true_ : cache_tag::false_);
+            } else if (auto ptr = value.as<int64_t>()) {
+                write_tag(cache_tag::integer);
+                write_raw(*ptr);
+            } else if (auto ptr = value.as<double>()) {
+                write_tag(cache_tag::floating);
+                write_raw(*ptr);
+            } else if (auto ptr = value.as<std::string>()) {
+                write_tag(cache_tag::string);
+                write(*ptr);
+            } else if (auto ptr = value.as<values::array>()) {
+                write_tag(cache_tag::array);
+                write_size(ptr->size());
+                for (auto const& element : *ptr) {
+                    write(element);
+                }
+            } else if (auto ptr = value.as<values::hash>()) {
+                write_tag(cache_tag::hash);
+                write_size(ptr->size());
+                for (auto const& kvp : *ptr) {
+                    write(kvp.key());
+                    write(kvp.value());
+                }
+            } else {
+                throw runtime_error("unexpected fact value type.");
+            }
+        }
+
+        void write_size(size_t size)
+        {
+            write_raw(static_cast<uint64_t>(size));
+        }
+
+        void write_uint64(uint64_t value)
+        {
+            write_raw(value);
+        }
+
+        void write_int64(int64_t value)
+        {
+            write_raw(value);
+        }
+
+     private:
+        void write_tag(cache_tag tag)
+        {
+            _stream.put(static_cast<char>(tag));
+        }
+
+        template <typename T>
+        void write_raw(T value)
+        {
+            // The cache is only read on the machine that wrote it, so values are written in native byte order
+            _stream.write(reinterpret_cast<char const*>(&value), sizeof(value));
+        }
+
+        ostream& _stream;
+    };
+
+    struct cache_reader
+    {
+        explicit cache_reader(string const& buffer) :
+            _current(buffer.data()),
+            _end(buffer.data() + buffer.size())
+        {
+        }
+
+        bool read_magic()
+        {
+            if (static_cast<size_t>(_end - _current) < cache_magic_size || memcmp(_current, cache_magic, cache_magic_size) != 0) {
+                return false;
+            }
+            _current += cache_magic_size;
+            return true;
+        }
+
+        uint64_t read_uint64()
+        {
+            return read_raw<uint64_t>();
+        }
+
+        int64_t read_int64()
+        {
+            return read_raw<int64_t>();
+        }
+
+        string read_string()
+        {
+            auto size = read_size();
+            ensure(size);
+            string value{ _current, size };
+            _current += size;
+            return value;
+        }
+
+        values::value read_value()
+        {
+            ensure(1);
+            auto tag = static_cast<cache_tag>(*_current++);
+            switch (tag) {
+                case cache_tag::undef:
+                    return values::undef();
+
+                case cache_tag::false_:
+                    return false;
+
+                case cache_tag::true_:
+                    return true;
+
+                case cache_tag::integer:
+                    return read_raw<int64_t>();
+
+                case cache_tag::floating:
+                    return read_raw<double>();
+
+                case cache_tag::string:
+                    return read_string();
+
+                case cache_tag::array: {
+                    auto size = read_size();
+                    values::array array;
+                    // Every element takes at least one byte, so don't trust a size larger than the remaining input
+                    ensure(size);
+                    array.reserve(size);
+                    for (size_t i = 0; i < size; ++i) {
+                        array.emplace_back(read_value());
+                    }
+                    return rvalue_cast(array);
+                }
+
+                case cache_tag::hash: {
+                    auto size = read_size();
+                    values::hash hash;
+                    for (size_t i = 0; i < size; ++i) {
+                        auto key = read_value();
+                        hash.set(rvalue_cast(key), read_value());
+                    }
+                    return rvalue_cast(hash);
+                }
+            }
+            throw runtime_error("unexpected fact value tag.");
+        }
+
+        size_t read_size()
+        {
+            return static_cast<size_t>(read_raw<uint64_t>());
+        }
+
+        bool done() const
+        {
+            return _current == _end;
+        }
+
+     private:
+        template <typename T>
+        T read_raw()
+        {
+            T value;
+            ensure(sizeof(value));
+            memcpy(&value, _current, sizeof(value));
+            _current += sizeof(value);
+            return value;
+        }
+
+        void ensure(size_t size) const
+        {
+            if (static_cast<size_t>(_end - _current) < size) {
+                throw runtime_error("unexpected end of facts cache.");
+            }
+        }
+
+        char const* _current;
+        char const* _end;
+    };
+
+    cache::cache(string path) :
+        _path(rvalue_cast(path)),
+        _cache_path(_path + ".cache"),
+        _source_size(0),
+        _source_time(0),
+        _source_valid(false)
+    {
+        // Record the facts file's status before it is parsed so that a change made while parsing invalidates the cache
+        sys::error_code ec;
+        auto size = fs::file_size(_path, ec);
+        if (ec) {
+            return;
+        }
+        auto time = fs::last_write_time(_path, ec);
+        if (ec) {
+            return;
+        }
+        _source_size = static_cast<uint64_t>(size);
+        _source_time = static_cast<int64_t>(time);
+        _source_valid = true;
+    }
+
+    bool cache::load(fact_map& facts) const
+    {
+        if (!_source_valid) {
+            return false;
+        }
+
+        ifstream stream{ _cache_path, ios_base::in | ios_base::binary };
+        if (!stream) {
+            return false;
+        }
+        ostringstream contents;
+        contents << stream.rdbuf();
+        auto buffer = contents.str();
+
+        try {
+            cache_reader reader{ buffer };
+            if (!reader.read_magic()) {
+                return false;
+            }
+
+            // Only use the cache if it was written for a facts file of the same size and modification time
+            // Comparing for equality rather than comparing the cache's own timestamp handles edits within the same second
+            // that change the size and facts files that are replaced with older ones
+            auto size = reader.read_uint64();
+            auto time = reader.read_int64();
+            if (size != _source_size || time != _source_time) {
+                return false;
+            }
+
+            fact_map loaded;
+            auto count = reader.read_size();
+            for (size_t i = 0; i < count; ++i) {
+                auto name = reader.read_string();
+                loaded.emplace(rvalue_cast(name), std::make_shared<values::value>(reader.read_value()));
+            }
+            if (!reader.done()) {
+                return false;
+            }
+            facts = rvalue_cast(loaded);
+            return true;
+        } catch (runtime_error const&) {
+            // Treat an invalid cache as missing
+            return false;
+        }
+    }
+
+    void cache::save(fact_map const& facts) const
+    {
+        if (!_source_valid) {
+            return;
+        }
+
+        // Write to a temporary file and rename it into place so a concurrent load never sees a partial cache
+        auto temporary_path = _cache_path + ".tmp";
+        try {
+            {
+                ofstream stream{ temporary_path, ios_base::out | ios_base::binary | ios_base::trunc };
+                if (!stream) {
+                    return;
+                }
+                stream.write(cache_magic, cache_magic_size);
+
+                cache_writer writer{ stream };
+                writer.write_uint64(_source_size);
+                writer.write_int64(_source_time);
+                writer.write_size(facts.size());
+                for (auto const& kvp : facts) {
+                    writer.write(kvp.first);
+                    writer.write(*kvp.second);
+                }
+                if (!stream) {
+                    throw runtime_error("failed to write facts cache.");
+                }
+            }
+            fs::rename(temporary_path, _cache_path);
+        } catch (exception const&) {
+            sys::error_code ec;
+            fs::remove(temporary_path, ec);
+        }
+    }
+
+}}  // namespace puppet::facts
@@ -12,43 +12,35 @@ using namespace facter::facts;
 
 namespace puppet { namespace facts {
 
-    facter::facter()
+    facter::facter() :
+        _initialized(false)
     {
-        // Add default facts
-        _collection.add_default_facts(false);
-        _collection.add_external_facts();
-
-        // TODO: support additional locations for external facts?
-        _collection.add_environment_facts();
-
-        // TODO: add custom facts?  Need to initialize the Ruby VM in main
     }
 
     shared_ptr<values::value const> facter::lookup(string const& name)
     {
-        shared_ptr<values::value const> value;
-
-        // First check the cache
+        // First check the cache (which also remembers facts that do not exist)
         auto it = _cache.find(name);
         if (it == _cache.end()) {
-            // Not in cache, check the fact collection
-            store(name, _collection[name]);
-            it = _cache.find(name);
+            // Not in cache, resolve only this fact from the collection
+            store(name, collection()[name]);
+            it = _cache.emplace(name, nullptr).first;
         }
-        if (it != _cache.end()) {
-            value = it->second;
-        }
-        return value;
+        return it->second;
     }
 
     void facter::each(bool accessed, function<bool(string const&, shared_ptr<values::value const> const&)> const& callback)
     {
         // If all facts, enumerate all the facts and store in the cache
         if (!accessed) {
-            _collection.each([this](string const& name, ::facter::facts::value const* value) {
-                if (_cache.count(name)) {
+            collection().each([this](string const& name, ::facter::facts::value const* value) {
+                auto it = _cache.find(name);
+                if (it != _cache.end() && it->second) {
                     return true;
                 }
+                if (it != _cache.end()) {
+                    _cache.erase(it);
+                }
                 store(name, value);
                 return true;
             });
@@ -56,12 +48,40 @@ namespace puppet { namespace facts {
 
         // Enumerate what's in the cache
         for (auto& kvp : _cache) {
+            // Skip facts that were looked up but do not exist
+            if (!kvp.second) {
+                continue;
+            }
             if (!callback(kvp.first, kvp.second)) {
                 break;
             }
         }
     }
 
+    void facter::initialize(::facter::facts::collection& collection)
+    {
+        // Add the default facts; this only adds the resolvers as facter resolves facts when they are first queried
+        collection.add_default_facts(false);
+
+        // External and environment facts can override any fact, so they are added before the first fact is resolved
+        // Unlike the default facts, these are resolved as they are added
+        collection.add_external_facts();
+
+        // TODO: support additional locations for external facts?
+        collection.add_environment_facts();
+
+        // TODO: add custom facts?  Need to initialize the Ruby VM in main
+    }
+
+    ::facter::facts::collection& facter::collection()
+    {
+        if (!_initialized) {
+            _initialized = true;
+            initialize(_collection);
+        }
+        return _collection;
+    }
+
     void facter::store(string const& name, ::facter::facts::value const* value, values::value* parent)
     {
         if (!value) {
@@ -0,0 +1,216 @@
+#include <puppet/facts/json.hpp>
+#include <puppet/facts/cache.hpp>
+#include <puppet/compiler/lexer/lexer.hpp>
+#include <puppet/cast.hpp>
+#include <boost/format.hpp>
+#include <boost/algorithm/string.hpp>
+#include <rapidjson/reader.h>
+#include <rapidjson/error/en.h>
+#include <fstream>
+#include <sstream>
+#include <limits>
+
+using namespace std;
+using namespace puppet::compiler::lexer;
+using namespace puppet::runtime;
+
+namespace puppet { namespace facts {
+
+    // Builds fact values directly from the parser's events rather than through an intermediate document
+    struct fact_handler : rapidjson::BaseReaderHandler<rapidjson::UTF8<>, fact_handler>
+    {
+        explicit fact_handler(unordered_map<string, shared_ptr<values::value const>>& facts) :
+            _facts(facts)
+        {
+        }
+
+        bool Null()
+        {
+            return add(values::undef());
+        }
+
+        bool Bool(bool value)
+        {
+            return add(value);
+        }
+
+        bool Int(int value)
+        {
+            return add(static_cast<int64_t>(value));
+        }
+
+        bool Uint(unsigned value)
+        {
+            return add(static_cast<int64_t>(value));
+        }
+
+        bool Int64(int64_t value)
+        {
+            return add(value);
+        }
+
+        bool Uint64(uint64_t value)
+        {
+            // Values too large for an Integer are converted to a Float
+            if (value > static_cast<uint64_t>(numeric_limits<int64_t>::max())) {
+                return add(static_cast<double>(value));
+            }
+            return add(static_cast<int64_t>(value));
+        }
+
+        bool Double(double value)
+        {
+            return add(value);
+        }
+
+        bool String(char const* value, rapidjson::SizeType length, bool)
+        {
+            return add(string{ value, length });
+        }
+
+        bool Key(char const* value, rapidjson::SizeType length, bool)
+        {
+            _keys.emplace_back(value, length);
+            return true;
+        }
+
+        bool StartObject()
+        {
+            _stack.emplace_back(values::hash());
+            return true;
+        }
+
+        bool EndObject(rapidjson::SizeType)
+        {
+            return pop();
+        }
+
+        bool StartArray()
+        {
+            // The facts must be an object
+            if (_stack.empty()) {
+                return false;
+            }
+            _stack.emplace_back(values::array());
+            return true;
+        }
+
+        bool EndArray(rapidjson::SizeType)
+        {
+            return pop();
+        }
+
+     private:
+        bool pop()
+        {
+            auto value = rvalue_cast(_stack.back());
+            _stack.pop_back();
+
+            // The root object has already been stored fact by fact
+            if (_stack.empty()) {
+                return true;
+            }
+            return add(rvalue_cast(value));
+        }
+
+        bool add(values::value value)
+        {
+            // The facts must be an object
+            if (_stack.empty()) {
+                return false;
+            }
+
+            // Members of the root object are the facts
+            if (_stack.size() == 1) {
+                _facts.emplace(boost::to_lower_copy(_keys.back()), std::make_shared<values::value>(rvalue_cast(value)));
+                _keys.pop_back();
+                return true;
+            }
+
+            // boost::get is used here because we know the parent is an array or hash and not a variable
+            auto& parent = _stack.back();
+            if (auto ptr = boost::get<values::array>(&parent)) {
+                ptr->emplace_back(rvalue_cast(value));
+            } else if (auto ptr = boost::get<values::hash>(&parent)) {
+                ptr->set(rvalue_cast(_keys.back()), rvalue_cast(value));
+                _keys.pop_back();
+            }
+            return true;
+        }
+
+        unordered_map<string, shared_ptr<values::value const>>& _facts;
+        vector<values::value> _stack;
+        vector<string> _keys;
+    };
+
+    json_parse_exception::json_parse_exception(string const& message, string path, size_t line, size_t column, string text) :
+        runtime_error(message),
+        _path(rvalue_cast(path)),
+        _line(line),
+        _column(column),
+        _text(rvalue_cast(text))
+    {
+    }
+
+    string const& json_parse_exception::path() const
+    {
+        return _path;
+    }
+
+    size_t json_parse_exception::line() const
+    {
+        return _line;
+    }
+
+    size_t json_parse_exception::column() const
+    {
+        return _column;
+    }
+
+    string const& json_parse_exception::text() const
+    {
+        return _text;
+    }
+
+    json::json(string const& path, bool use_cache)
+    {
+        facts::cache cache{ path };
+        if (use_cache && cache.load(_cache)) {
+            return;
+        }
+
+        // Read the entire fact file into memory
+        ifstream stream(path);
+        if (!stream) {
+            throw json_parse_exception((boost::format("cannot open facts file '%1%'.") % path).str());
+        }
+        ostringstream contents;
+        contents << stream.rdbuf();
+        auto buffer = contents.str();
+
+        // Parse the facts
+        fact_handler handler{ _cache };
+        rapidjson::Reader reader;
+        rapidjson::StringStream input{ buffer.c_str() };
+        auto result = reader.Parse(input, handler);
+        if (!result) {
+            auto offset = min(result.Offset(), buffer.size());
+            auto info = get_line_info(buffer, offset, 1);
+            auto message = result.Code() == rapidjson::kParseErrorTermination ?
+                string{ "expected a JSON object" } :
+                string{ rapidjson::GetParseError_En(result.Code()) };
+            boost::trim_right_if(message, boost::is_any_of("."));
+            throw json_parse_exception(
+                (boost::format("failed parsing facts: %1%.") % message).str(),
+                path,
+                static_cast<size_t>(count(buffer.begin(), buffer.begin() + offset, '\n')) + 1,
+                info.column,
+                rvalue_cast(info.text));
+        }
+
+        if (use_cache) {
+            cache.save(_cache);
+        }
+    }
+
+}}  // namespace puppet::facts
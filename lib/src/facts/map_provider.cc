@@ -0,0 +1,35 @@
+#include <puppet/facts/map_provider.hpp>
+
+using namespace std;
+using namespace puppet::runtime;
+
+namespace puppet { namespace facts {
+
+    shared_ptr<values::value const> map_provider::lookup(string const& name)
+    {
+        // Check the cache for the value
+        auto it = _cache.find(name);
+        if (it != _cache.end()) {
+            _accessed[name] = it->second;
+            return it->second;
+        }
+        return nullptr;
+    }
+
+    void map_provider::each(bool accessed, function<bool(string const&, shared_ptr<values::value const> const&)> const& callback)
+    {
+        // Default to the entire cache
+        auto ptr = &_cache;
+        if (accessed) {
+            ptr = &_accessed;
+        }
+
+        // Enumerate all of the items in the collection
+        for (auto const& kvp : *ptr) {
+            if (!callback(kvp.first, kvp.second)) {
+                break;
+            }
+        }
+    }
+
+}}  // namespace puppet::facts
@@ -0,0 +1,250 @@
+#include <puppet/facts/store.hpp>
+#include <puppet/cast.hpp>
+#include <boost/functional/hash.hpp>
+#include <unordered_set>
+#include <vector>
+#include <mutex>
+
+using namespace std;
+using namespace puppet::runtime;
+
+namespace puppet { namespace facts {
+
+    struct store::node
+    {
+        enum class category
+        {
+            scalar,
+            array,
+            hash
+        };
+
+        category kind = category::scalar;
+        size_t hash = 0;
+
+        // The value of a scalar node
+        values::value scalar;
+
+        // The elements of an array node or the keys and values (interleaved) of a hash node
+        // Children are interned before their parent, so two nodes are identical if they have the same children
+        vector<node_pointer> children;
+
+        // The node itself, used to tell if a node found in the index is being destroyed
+        weak_ptr<node const> self;
+
+        // The runtime value last created for the node; guarded by the index mutex
+        mutable weak_ptr<values::value const> value;
+    };
+
+    // Fact values can only be shared if they are identical, so unlike the Puppet equality operator
+    // strings are compared case sensitively and values of different types (e.g. 1 and 1.0) are never equal
+    static bool identical(values::value const& left, values::value const& right)
+    {
+        if (left.which() != right.which()) {
+            return false;
+        }
+        if (auto ptr = left.as<std::string>()) {
+            return *ptr == *right.as<std::string>();
+        }
+        return left == right;
+    }
+
+    struct store::index
+    {
+        struct node_hash
+        {
+            size_t operator()(node const* node) const
+            {
+                return node->hash;
+            }
+        };
+
+        struct node_equal
+        {
+            bool operator()(node const* left, node const* right) const
+            {
+                if (left == right) {
+                    return true;
+                }
+                if (left->kind != right->kind || left->hash != right->hash) {
+                    return false;
+                }
+                if (left->kind == node::category::scalar) {
+                    return identical(left->scalar, right->scalar);
+                }
+                return left->children == right->children;
+            }
+        };
+
+        void release(node const* node)
+        {
+            {
+                lock_guard<std::mutex> lock{ mutex };
+
+                // Only remove the node itself; an identical node may have replaced it while it was being released
+                auto it = nodes.find(node);
+                if (it != nodes.end() && *it == node) {
+                    nodes.erase(it);
+                }
+            }
+
+            // Delete outside of the lock as releasing the children may release their nodes too
+            delete node;
+        }
+
+        std::mutex mutex;
+        unordered_set<node const*, node_hash, node_equal> nodes;
+    };
+
+    static values::value create_value(store::node const& node)
+    {
+        if (node.kind == store::node::category::array) {
+            values::array array;
+            array.reserve(node.children.size());
+            for (auto const& child : node.children) {
+                array.emplace_back(create_value(*child));
+            }
+            return array;
+        }
+        if (node.kind == store::node::category::hash) {
+            values::hash hash;
+            for (size_t i = 0; i + 1 < node.children.size(); i += 2) {
+                hash.set(create_value(*node.children[i]), create_value(*node.children[i + 1]));
+            }
+            return hash;
+        }
+        return node.scalar;
+    }
+
+    store::store() :
+        _index(make_shared<index>())
+    {
+    }
+
+    store::node_pointer store::intern(values::value const& value)
+    {
+        unique_ptr<node> created{ new node() };
+        size_t seed = 0;
+
+        if (auto array = value.as<values::array>()) {
+            created->kind = node::category::array;
+            created->children.reserve(array->size());
+            for (auto const& element : *array) {
+                created->children.emplace_back(intern(*element));
+            }
+        } else if (auto hash = value.as<values::hash>()) {
+            created->kind = node::category::hash;
+            created->children.reserve(hash->size() * 2);
+            for (auto const& kvp : *hash) {
+                created->children.emplace_back(intern(kvp.key()));
+                created->children.emplace_back(intern(kvp.value()));
+            }
+        } else {
+            created->scalar = value;
+            boost::hash_combine(seed, hash_value(created->scalar));
+        }
+
+        // Children are unique in the store, so their addresses identify them
+        boost::hash_combine(seed, static_cast<int>(created->kind));
+        for (auto const& child : created->children) {
+            boost::hash_combine(seed, child.get());
+        }
+        created->hash = seed;
+
+        lock_guard<std::mutex> lock{ _index->mutex };
+
+        auto it = _index->nodes.find(created.get());
+        if (it != _index->nodes.end()) {
+            if (auto existing = (*it)->self.lock()) {
+                return existing;
+            }
+            // The existing node is being released, so replace it
+            _index->nodes.erase(it);
+        }
+
+        auto index = _index;
+        shared_ptr<node> result{ created.release(), [index](node const* node) { index->release(node); } };
+        result->self = result;
+        _index->nodes.insert(result.get());
+        return result;
+    }
+
+    shared_ptr<values::value const> store::value(node_pointer const& node) const
+    {
+        {
+            lock_guard<std::mutex> lock{ _index->mutex };
+            if (auto value = node->value.lock()) {
+                return value;
+            }
+        }
+
+        // Create the value outside of the lock; if another thread created one first, use that value instead
+        auto value = make_shared<values::value const>(create_value(*node));
+
+        lock_guard<std::mutex> lock{ _index->mutex };
+        if (auto existing = node->value.lock()) {
+            return existing;
+        }
+        node->value = value;
+        return value;
+    }
+
+    size_t store::size() const
+    {
+        lock_guard<std::mutex> lock{ _index->mutex };
+        return _index->nodes.size();
+    }
+
+    view::view(shared_ptr<facts::store> store, provider& facts) :
+        _store(rvalue_cast(store))
+    {
+        if (!_store) {
+            throw runtime_error("expected a fact store.");
+        }
+
+        // Intern each of the node's facts in the shared store
+        facts.each(false, [&](string const& name, shared_ptr<values::value const> const& value) {
+            if (value) {
+                _facts.emplace(name, _store->intern(*value));
+            }
+            return true;
+        });
+    }
+
+    shared_ptr<values::value const> view::lookup(string const& name)
+    {
+        auto accessed = _accessed.find(name);
+        if (accessed != _accessed.end()) {
+            return accessed->second;
+        }
+
+        auto it = _facts.find(name);
+        if (it == _facts.end()) {
+            return nullptr;
+        }
+        auto value = _store->value(it->second);
+        _accessed.emplace(name, value);
+        return value;
+    }
+
+    void view::each(bool accessed, function<bool(string const&, shared_ptr<values::value const> const&)> const& callback)
+    {
+        if (accessed) {
+            for (auto const& kvp : _accessed) {
+                if (!callback(kvp.first, kvp.second)) {
+                    break;
+                }
+            }
+            return;
+        }
+
+        // Enumerating all facts creates the value of every fact
+        for (auto const& kvp : _facts) {
+            auto it = _accessed.find(kvp.first);
+            if (!callback(kvp.first, it == _accessed.end() ? _store->value(kvp.second) : it->second)) {
+                break;
+            }
+        }
+    }
+
+}}  // namespace puppet::facts
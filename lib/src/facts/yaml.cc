@@ -1,4 +1,5 @@
 #include <puppet/facts/yaml.hpp>
+#include <puppet/facts/cache.hpp>
 #include <puppet/compiler/lexer/lexer.hpp>
 #include <puppet/cast.hpp>
 #include <boost/format.hpp>
@@ -42,8 +43,13 @@ namespace puppet { namespace facts {
         return _text;
     }
 
-    yaml::yaml(string const& path)
+    yaml::yaml(string const& path, bool use_cache)
     {
+        facts::cache cache{ path };
+        if (use_cache && cache.load(_cache)) {
+            return;
+        }
+
         // Parse the fact file
         ifstream stream(path);
         if (!stream) {
@@ -58,32 +64,9 @@ namespace puppet { namespace facts {
             auto info = get_line_info(stream, ex.mark.pos, 1);
             throw yaml_parse_exception((boost::format("failed parsing facts: %1%.") % ex.msg).str(), path, ex.mark.line + 1, info.column, rvalue_cast(info.text));
         }
-    }
 
-    shared_ptr<values::value const> yaml::lookup(string const& name)
-    {
-        // Check the cache for the value
-        auto it = _cache.find(name);
-        if (it != _cache.end()) {
-            _accessed[name] = it->second;
-            return it->second;
-        }
-        return nullptr;
-    }
-
-    void yaml::each(bool accessed, function<bool(string const&, shared_ptr<values::value const> const&)> const& callback)
-    {
-        // Default to the entire cache
-        auto ptr = &_cache;
-        if (accessed) {
-            ptr = &_accessed;
-        }
-
-        // Enumerate all of the items in the collection
-        for (auto kvp : *ptr) {
-            if (!callback(kvp.first, kvp.second)) {
-                break;
-            }
+        if (use_cache) {
+            cache.save(_cache);
         }
     }
 
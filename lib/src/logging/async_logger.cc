@@ -0,0 +1,203 @@
+#include <puppet/logging/async_logger.hpp>
+#include <puppet/cast.hpp>
+
+using namespace std;
+
+namespace puppet { namespace logging {
+
+    async_logger::async_logger(logger& target, size_t capacity) :
+        _target(target),
+        _mask(0),
+        _enqueue_position(0),
+        _dequeue_position(0),
+        _written(0),
+        _waiting(false),
+        _stopping(false),
+        _blocked(0)
+    {
+        // The capacity must be a power of two so that positions can be masked into the buffer
+        size_t size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        _cells.reset(new cell[size]);
+        for (size_t i = 0; i < size; ++i) {
+            _cells[i].sequence.store(i, memory_order_relaxed);
+        }
+        _mask = size - 1;
+
+        // The target writes everything it is given; this logger does the filtering
+        _target.level(logging::level::debug);
+
+        _thread = std::thread([this]() { run(); });
+    }
+
+    async_logger::~async_logger()
+    {
+        _stopping.store(true, memory_order_release);
+        {
+            lock_guard<mutex> lock{ _mutex };
+            _wake.notify_one();
+        }
+        _thread.join();
+    }
+
+    void async_logger::flush()
+    {
+        auto position = _enqueue_position.load(memory_order_acquire);
+        wait_for_progress([&]() { return _written.load() >= position; });
+    }
+
+    void async_logger::log_message(logging::level level, size_t line, size_t column, size_t length, string const& text, string const& path, string const& message)
+    {
+        entry data{ level, line, column, length, text, path, message };
+
+        // If the buffer is full, block until the background thread has written a message and try again
+        while (true) {
+            auto written = _written.load();
+            if (try_enqueue(data)) {
+                break;
+            }
+            wait_for_progress([&]() { return _written.load() != written; });
+        }
+        wake();
+    }
+
+    void async_logger::log_backtrace(vector<compiler::evaluation::stack_frame> const& backtrace)
+    {
+        flush();
+
+        lock_guard<mutex> lock{ _target_mutex };
+        _target.log(backtrace);
+    }
+
+    bool async_logger::try_enqueue(entry& data)
+    {
+        // This is a bounded multi-producer, multi-consumer queue where each cell's sequence number
+        // tells producers and consumers whether the cell is ready for them
+        auto position = _enqueue_position.load(memory_order_relaxed);
+        while (true) {
+            auto& cell = _cells[position & _mask];
+            auto sequence = cell.sequence.load(memory_order_acquire);
+            auto difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+            if (difference == 0) {
+                if (_enqueue_position.compare_exchange_weak(position, position + 1, memory_order_relaxed)) {
+                    cell.data = rvalue_cast(data);
+                    cell.sequence.store(position + 1, memory_order_release);
+                    return true;
+                }
+            } else if (difference < 0) {
+                // The buffer is full
+                return false;
+            } else {
+                position = _enqueue_position.load(memory_order_relaxed);
+            }
+        }
+    }
+
+    bool async_logger::try_dequeue(entry& data)
+    {
+        auto position = _dequeue_position.load(memory_order_relaxed);
+        while (true) {
+            auto& cell = _cells[position & _mask];
+            auto sequence = cell.sequence.load(memory_order_acquire);
+            auto difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+            if (difference == 0) {
+                if (_dequeue_position.compare_exchange_weak(position, position + 1, memory_order_relaxed)) {
+                    data = rvalue_cast(cell.data);
+                    cell.sequence.store(position + _mask + 1, memory_order_release);
+                    return true;
+                }
+            } else if (difference < 0) {
+                // The buffer is empty
+                return false;
+            } else {
+                position = _dequeue_position.load(memory_order_relaxed);
+            }
+        }
+    }
+
+    bool async_logger::has_message() const
+    {
+        // Only the background thread dequeues, so the next cell is ready once its sequence has been published
+        auto position = _dequeue_position.load(memory_order_relaxed);
+        return _cells[position & _mask].sequence.load(memory_order_acquire) == position + 1;
+    }
+
+    void async_logger::wake()
+    {
+        // The fence pairs with the one in run(): either the background thread sees the message before it waits
+        // or this thread sees the waiting flag and signals under the lock the background thread waits with
+        atomic_thread_fence(memory_order_seq_cst);
+        if (_waiting.load(memory_order_relaxed)) {
+            lock_guard<mutex> lock{ _mutex };
+            _wake.notify_one();
+        }
+    }
+
+    void async_logger::wait_for_progress(function<bool()> const& done)
+    {
+        // The background thread only notifies when a thread is blocked; registering under the lock before
+        // checking the condition ensures a message written after the check is not missed
+        unique_lock<mutex> lock{ _mutex };
+        ++_blocked;
+        _wake.notify_one();
+        _progress.wait(lock, done);
+        --_blocked;
+    }
+
+    void async_logger::run()
+    {
+        entry data;
+        while (true) {
+            if (try_dequeue(data)) {
+                {
+                    lock_guard<mutex> lock{ _target_mutex };
+                    _target.log(data.level, data.line, data.column, data.length, data.text, data.path, data.message);
+                }
+                _written.fetch_add(1);
+
+                // Wake any threads waiting for room in the buffer or for a flush
+                if (_blocked.load() > 0) {
+                    lock_guard<mutex> lock{ _mutex };
+                    _progress.notify_all();
+                }
+                continue;
+            }
+
+            // Exit only once the buffer has been drained
+            if (_stopping.load(memory_order_acquire)) {
+                if (_written.load(memory_order_acquire) == _enqueue_position.load(memory_order_acquire)) {
+                    break;
+                }
+                this_thread::yield();
+                continue;
+            }
+
+            // Wait for more messages; publishing the waiting flag before checking for a message ensures a producer
+            // that enqueues after the check will signal
+            unique_lock<mutex> lock{ _mutex };
+            _waiting.store(true, memory_order_relaxed);
+            atomic_thread_fence(memory_order_seq_cst);
+            _wake.wait(lock, [&]() { return _stopping.load(memory_order_acquire) || has_message(); });
+            _waiting.store(false, memory_order_relaxed);
+        }
+    }
+
+    child_logger::child_logger(logger& parent) :
+        _parent(parent)
+    {
+        level(_parent.level());
+    }
+
+    void child_logger::log_message(logging::level level, size_t line, size_t column, size_t length, string const& text, string const& path, string const& message)
+    {
+        _parent.log(level, line, column, length, text, path, message);
+    }
+
+    void child_logger::log_backtrace(vector<compiler::evaluation::stack_frame> const& backtrace)
+    {
+        _parent.log(backtrace);
+    }
+
+}}  // namespace puppet::logging
@@ -1,4 +1,5 @@
 #include <puppet/logging/logger.hpp>
+#include <puppet/cast.hpp>
 #include <boost/algorithm/string.hpp>
 #include <sstream>
 #include <iomanip>
@@ -92,12 +93,13 @@ namespace puppet { namespace logging {
 
     void logger::reset()
     {
-        _warnings = _errors = 0;
+        _warnings = 0;
+        _errors = 0;
     }
 
     bool logger::would_log(logging::level level)
     {
-        return static_cast<size_t>(level) >= static_cast<size_t>(_level);
+        return static_cast<size_t>(level) >= static_cast<size_t>(_level.load());
     }
 
     void stream_logger::log_message(logging::level level, size_t line, size_t column, size_t length, string const& text, string const& path, string const& message)
@@ -241,4 +243,147 @@ namespace puppet { namespace logging {
         return level >= logging::level::warning ? _colorize_stderr : _colorize_stdout;
     }
 
+    // The size the buffer may grow to before it is written to the stream
+    static const size_t JSON_BUFFER_SIZE = 64 * 1024;
+
+    json_logger::json_logger(ostream& stream, string node) :
+        _stream(stream),
+        _node(rvalue_cast(node))
+    {
+        _buffer.reserve(JSON_BUFFER_SIZE);
+    }
+
+    json_logger::~json_logger()
+    {
+        flush();
+    }
+
+    void json_logger::flush()
+    {
+        if (_buffer.empty()) {
+            return;
+        }
+        _stream.write(_buffer.data(), _buffer.size());
+        _stream.flush();
+        _buffer.clear();
+    }
+
+    void json_logger::log_message(logging::level level, size_t line, size_t column, size_t, string const&, string const& path, string const& message)
+    {
+        write_level(level);
+
+        if (!path.empty()) {
+            _buffer += ",\"path\":";
+            write_string(path);
+            if (line > 0) {
+                _buffer += ",\"line\":";
+                _buffer += to_string(line);
+            }
+            if (column > 0) {
+                _buffer += ",\"column\":";
+                _buffer += to_string(column);
+            }
+        }
+        if (!_node.empty()) {
+            _buffer += ",\"node\":";
+            write_string(_node);
+        }
+        _buffer += ",\"message\":";
+        write_string(message);
+        end_line(level);
+    }
+
+    void json_logger::log_backtrace(vector<compiler::evaluation::stack_frame> const& backtrace)
+    {
+        write_level(logging::level::error);
+
+        if (!_node.empty()) {
+            _buffer += ",\"node\":";
+            write_string(_node);
+        }
+        _buffer += ",\"backtrace\":[";
+
+        ostringstream frame;
+        for (size_t i = 0; i < backtrace.size() && i < MAX_BACKTRACE_COUNT; ++i) {
+            if (i > 0) {
+                _buffer += ',';
+            }
+            frame.str({});
+            frame << backtrace[i];
+            write_string(frame.str());
+        }
+        _buffer += ']';
+        end_line(logging::level::error);
+    }
+
+    void json_logger::write_level(logging::level level)
+    {
+        // Keep this in sync with the definition of logging::level
+        static char const* const levels[] = {
+            "{\"level\":\"debug\"",
+            "{\"level\":\"info\"",
+            "{\"level\":\"notice\"",
+            "{\"level\":\"warning\"",
+            "{\"level\":\"error\"",
+            "{\"level\":\"alert\"",
+            "{\"level\":\"emergency\"",
+            "{\"level\":\"critical\""
+        };
+        static_assert(sizeof(levels) / sizeof(levels[0]) == static_cast<size_t>(logging::level::critical) + 1, "expected a JSON level for every logging level.");
+
+        size_t index = static_cast<size_t>(level);
+        _buffer += index < sizeof(levels) / sizeof(levels[0]) ? levels[index] : "{\"level\":\"unknown\"";
+    }
+
+    void json_logger::write_string(string const& value)
+    {
+        static char const hex[] = "0123456789abcdef";
+
+        _buffer += '"';
+        for (auto c : value) {
+            switch (c) {
+                case '"':
+                    _buffer += "\\\"";
+                    break;
+
+                case '\\':
+                    _buffer += "\\\\";
+                    break;
+
+                case '\n':
+                    _buffer += "\\n";
+                    break;
+
+                case '\r':
+                    _buffer += "\\r";
+                    break;
+
+                case '\t':
+                    _buffer += "\\t";
+                    break;
+
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20) {
+                        _buffer += "\\u00";
+                        _buffer += hex[(c >> 4) & 0xF];
+                        _buffer += hex[c & 0xF];
+                    } else {
+                        _buffer += c;
+                    }
+                    break;
+            }
+        }
+        _buffer += '"';
+    }
+
+    void json_logger::end_line(logging::level level)
+    {
+        _buffer += "}\n";
+
+        // Write out errors immediately in case the process is about to exit
+        if (_buffer.size() >= JSON_BUFFER_SIZE || level >= logging::level::error) {
+            flush();
+        }
+    }
+
 }}  // namespace puppet::logging
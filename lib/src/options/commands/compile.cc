@@ -3,7 +3,9 @@
 #include <puppet/compiler/node.hpp>
 #include <puppet/compiler/exceptions.hpp>
 #include <puppet/facts/facter.hpp>
+#include <puppet/facts/json.hpp>
 #include <puppet/facts/yaml.hpp>
+#include <puppet/logging/async_logger.hpp>
 #include <puppet/utility/filesystem/helpers.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/algorithm/string.hpp>
@@ -56,8 +58,11 @@ namespace puppet { namespace options { namespace commands {
             (ENVIRONMENT_OPTION_FULL, po::value<string>()->default_value("production"), ENVIRONMENT_DESCRIPTION)
             (ENVIRONMENT_PATH_OPTION, po::value<string>(), ENVIRONMENT_PATH_DESCRIPTION)
             (FACTS_OPTION_FULL, po::value<string>(), FACTS_DESCRIPTION)
+            (FACTS_CACHE_OPTION, FACTS_CACHE_DESCRIPTION)
+            (FORMAT_OPTION, po::value<string>()->default_value("json"), FORMAT_DESCRIPTION)
             (GRAPH_FILE_OPTION_FULL, po::value<string>(), GRAPH_FILE_DESCRIPTION)
             (HELP_OPTION, HELP_DESCRIPTION)
+            (LOG_FORMAT_OPTION, po::value<string>()->default_value("text"), LOG_FORMAT_DESCRIPTION)
             (LOG_LEVEL_OPTION_FULL, po::value<string>()->default_value("notice"), command::LOG_LEVEL_DESCRIPTION)
             (MODULE_PATH_OPTION, po::value<string>(), MODULE_PATH_DESCRIPTION)
             (NODE_OPTION_FULL, po::value<string>(), NODE_DESCRIPTION)
@@ -77,8 +82,10 @@ namespace puppet { namespace options { namespace commands {
 
         // Get the options
         auto level = command::get_level(options);
+        auto log_format = get_log_format(options);
         auto colorization = get_colorization(options);
         auto output_file = get_output_file(options);
+        auto format = get_format(options);
         auto graph_file = get_graph_file(options);
         auto facts = get_facts(options);
         auto settings = create_settings(options);
@@ -91,21 +98,32 @@ namespace puppet { namespace options { namespace commands {
             *this,
             [
                 level,
+                log_format,
                 settings = rvalue_cast(settings),
                 manifests = rvalue_cast(manifests),
                 node_name = rvalue_cast(node_name),
                 facts = rvalue_cast(facts),
                 output_file = rvalue_cast(output_file),
+                format,
                 graph_file = rvalue_cast(graph_file),
                 trace = trace,
                 this
             ] () {
                 bool failed = true;
-                logging::console_logger logger;
+                // Write to the console from a background thread so that slow terminals or pipes do not stall compilation
+                unique_ptr<logging::logger> console;
+                if (log_format == commands::log_format::json) {
+                    console.reset(new logging::json_logger(cout, node_name));
+                } else {
+                    console.reset(new logging::console_logger());
+                }
+                logging::async_logger output{ *console };
+                output.level(level);
 
-                try {
-                    logger.level(level);
+                // Log through a child logger so that the warning and error counts are for this compilation only
+                logging::child_logger logger{ output };
 
+                try {
                     // TODO: support color/no-color options
 
                     LOG(debug, "using code directory '%1%'.", settings.get(settings::code_directory));
@@ -119,7 +137,7 @@ namespace puppet { namespace options { namespace commands {
                     compiler::node node{logger, node_name, environment, facts};
 
                     // Open the output file for writing
-                    ofstream output{ output_file };
+                    ofstream output{ output_file, format == catalog_format::msgpack ? (ios_base::out | ios_base::binary) : ios_base::out };
                     if (!output) {
                         throw option_exception((boost::format("cannot open '%1%' for writing.") % output_file).str(), this);
                     }
@@ -146,7 +164,7 @@ namespace puppet { namespace options { namespace commands {
 
                         // Write the catalog
                         LOG(notice, "writing catalog to '%1%'.", output_file);
-                        catalog.write(output);
+                        catalog.write(output, format);
 
                         // Command succeeded
                         failed = false;
@@ -166,6 +184,8 @@ namespace puppet { namespace options { namespace commands {
                     }
                 } catch (yaml_parse_exception const& ex) {
                     LOG(error, ex.line(), 1, ex.column(), ex.text(), ex.path(), ex.what());
+                } catch (json_parse_exception const& ex) {
+                    LOG(error, ex.line(), 1, ex.column(), ex.text(), ex.path(), ex.what());
                 } catch (exception const& ex) {
                     LOG(critical, "unhandled exception: %1%", ex.what());
                 }
@@ -188,13 +208,52 @@ namespace puppet { namespace options { namespace commands {
     shared_ptr<facts::provider> compile::get_facts(po::variables_map const& options) const
     {
         if (options.count(FACTS_OPTION)) {
-            return make_shared<facts::yaml>(options[FACTS_OPTION].as<string>());
+            auto path = options[FACTS_OPTION].as<string>();
+            bool use_cache = options.count(FACTS_CACHE_OPTION) > 0;
+
+            // Select the provider based on the file's extension
+            shared_ptr<facts::provider> provider;
+            if (boost::iequals(fs::path{ path }.extension().string(), ".json")) {
+                provider = make_shared<facts::json>(path, use_cache);
+            } else {
+                provider = make_shared<facts::yaml>(path, use_cache);
+            }
+
+            // The file's facts are all loaded, so intern them in the shared store and release the loaded copies
+            return make_shared<facts::view>(_facts, *provider);
         }
 
-        // Default to facter
+        // Default to facter; it resolves facts as they are looked up, so it is not viewed through the store
         return make_shared<facts::facter>();
     }
 
+    catalog_format compile::get_format(po::variables_map const& options) const
+    {
+        auto format = boost::algorithm::to_lower_copy(options[FORMAT_OPTION].as<string>());
+        if (format == "json") {
+            return catalog_format::json;
+        }
+        if (format == "compact-json") {
+            return catalog_format::compact_json;
+        }
+        if (format == "msgpack") {
+            return catalog_format::msgpack;
+        }
+        throw option_exception((boost::format("invalid catalog format '%1%': supported formats are json, compact-json, and msgpack.") % format).str(), this);
+    }
+
+    commands::log_format compile::get_log_format(po::variables_map const& options) const
+    {
+        auto format = boost::algorithm::to_lower_copy(options[LOG_FORMAT_OPTION].as<string>());
+        if (format == "text") {
+            return commands::log_format::text;
+        }
+        if (format == "json") {
+            return commands::log_format::json;
+        }
+        throw option_exception((boost::format("invalid log format '%1%': supported formats are text and json.") % format).str(), this);
+    }
+
     string compile::get_node(po::variables_map const& options, facts::provider& facts) const
     {
         // Check to see if it was explicitly set
@@ -206,43 +265,12 @@ namespace puppet { namespace options { namespace commands {
             return name;
         }
 
-        // If no node name was specified, use the FQDN fact and fallback to "<hostname>[.<domain>]".
-        auto networking = facts.lookup("networking");
-        if (networking) {
-            if (auto hash = networking->as<runtime::values::hash>()) {
-                auto fqdn = hash->get("fqdn");
-                if (fqdn) {
-                    if (auto str = fqdn->as<string>()) {
-                        name = *str;
-                    }
-                }
-                // Fallback to the hostname and domain if present
-                if (name.empty()) {
-                    auto hostname = hash->get("hostname");
-                    if (hostname) {
-                        if (auto str = hostname->as<string>()) {
-                            name = *str;
-                        }
-                        if (!name.empty()) {
-                            auto domain = hash->get("domain");
-                            if (domain) {
-                                if (auto str = domain->as<string>()) {
-                                    name += "." + *str;
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-        }
-
-        // Next try the legacy fqdn fact
-        if (name.empty()) {
-            auto fqdn = facts.lookup("fqdn");
-            if (fqdn) {
-                if (auto str = fqdn->as<string>()) {
-                    name = *str;
-                }
+        // If no node name was specified, use the legacy FQDN fact and fallback to "<hostname>[.<domain>]"
+        // These are checked before the structured networking fact as converting that fact includes every network interface
+        auto legacy_fqdn = facts.lookup("fqdn");
+        if (legacy_fqdn) {
+            if (auto str = legacy_fqdn->as<string>()) {
+                name = *str;
             }
         }
 
@@ -264,6 +292,38 @@ namespace puppet { namespace options { namespace commands {
             }
         }
 
+        // Lastly, try the structured networking fact for providers without the legacy facts
+        if (name.empty()) {
+            auto networking = facts.lookup("networking");
+            if (networking) {
+                if (auto hash = networking->as<runtime::values::hash>()) {
+                    auto fqdn = hash->get("fqdn");
+                    if (fqdn) {
+                        if (auto str = fqdn->as<string>()) {
+                            name = *str;
+                        }
+                    }
+                    // Fallback to the hostname and domain if present
+                    if (name.empty()) {
+                        auto hostname = hash->get("hostname");
+                        if (hostname) {
+                            if (auto str = hostname->as<string>()) {
+                                name = *str;
+                            }
+                            if (!name.empty()) {
+                                auto domain = hash->get("domain");
+                                if (domain) {
+                                    if (auto str = domain->as<string>()) {
+                                        name += "." + *str;
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
         // If still empty, user must explicitly specify
         if (name.empty()) {
             throw option_exception(
@@ -282,17 +342,23 @@ namespace puppet { namespace options { namespace commands {
         return {};
     }
 
-    char const* const compile::FACTS_OPTION           = "facts";
-    char const* const compile::FACTS_OPTION_FULL      = "facts,f";
-    char const* const compile::FACTS_DESCRIPTION      = "The path to the YAML facts file to use. Defaults to the current system's facts.";
-    char const* const compile::GRAPH_FILE_OPTION      = "graph-file";
-    char const* const compile::GRAPH_FILE_OPTION_FULL = "graph-file,g";
-    char const* const compile::GRAPH_FILE_DESCRIPTION = "The path to write a DOT language file for viewing the catalog dependency graph.";
-    char const* const compile::NODE_OPTION            = "node";
-    char const* const compile::NODE_OPTION_FULL       = "node,n";
-    char const* const compile::NODE_DESCRIPTION       = "The node name to use. Defaults to the 'fqdn' fact.";
-    char const* const compile::OUTPUT_DESCRIPTION     = "The output path for the compiled catalog.";
-    char const* const compile::TRACE_OPTION           = "trace";
-    char const* const compile::TRACE_DESCRIPTION      = "Display Puppet backtraces for evaluation errors.";
+    char const* const compile::FACTS_OPTION            = "facts";
+    char const* const compile::FACTS_OPTION_FULL       = "facts,f";
+    char const* const compile::FACTS_DESCRIPTION       = "The path to the YAML or JSON facts file to use. Defaults to the current system's facts.";
+    char const* const compile::FACTS_CACHE_OPTION      = "facts-cache";
+    char const* const compile::FACTS_CACHE_DESCRIPTION = "Cache the converted facts in a binary file next to the facts file.";
+    char const* const compile::FORMAT_OPTION           = "format";
+    char const* const compile::FORMAT_DESCRIPTION      = "The catalog output format.\nSupported formats: json, compact-json, msgpack.";
+    char const* const compile::GRAPH_FILE_OPTION       = "graph-file";
+    char const* const compile::GRAPH_FILE_OPTION_FULL  = "graph-file,g";
+    char const* const compile::GRAPH_FILE_DESCRIPTION  = "The path to write a DOT language file for viewing the catalog dependency graph.";
+    char const* const compile::LOG_FORMAT_OPTION       = "log-format";
+    char const* const compile::LOG_FORMAT_DESCRIPTION  = "The log output format.\nSupported formats: text, json.";
+    char const* const compile::NODE_OPTION             = "node";
+    char const* const compile::NODE_OPTION_FULL        = "node,n";
+    char const* const compile::NODE_DESCRIPTION        = "The node name to use. Defaults to the 'fqdn' fact.";
+    char const* const compile::OUTPUT_DESCRIPTION      = "The output path for the compiled catalog.";
+    char const* const compile::TRACE_OPTION            = "trace";
+    char const* const compile::TRACE_DESCRIPTION       = "Display Puppet backtraces for evaluation errors.";
 
 }}}  // namespace puppet::options::commands
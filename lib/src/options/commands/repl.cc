@@ -3,6 +3,7 @@
 #include <puppet/compiler/evaluation/repl.hpp>
 #include <puppet/compiler/exceptions.hpp>
 #include <puppet/utility/filesystem/helpers.hpp>
+#include <puppet/utility/regex.hpp>
 #include <boost/filesystem.hpp>
 
 #ifdef USE_Editline
@@ -136,6 +137,7 @@ namespace puppet { namespace options { namespace commands {
             (ENVIRONMENT_OPTION_FULL, po::value<string>()->default_value("production"), ENVIRONMENT_DESCRIPTION)
             (ENVIRONMENT_PATH_OPTION, po::value<string>(), ENVIRONMENT_PATH_DESCRIPTION)
             (FACTS_OPTION_FULL, po::value<string>(), FACTS_DESCRIPTION)
+            (FORMAT_OPTION, po::value<string>()->default_value("json"), FORMAT_DESCRIPTION)
             (GRAPH_FILE_OPTION_FULL, po::value<string>(), GRAPH_FILE_DESCRIPTION)
             (HELP_OPTION, HELP_DESCRIPTION)
             (command::LOG_LEVEL_OPTION_FULL, po::value<string>()->default_value("notice"), command::LOG_LEVEL_DESCRIPTION)
@@ -171,6 +173,7 @@ namespace puppet { namespace options { namespace commands {
         auto node_name = get_node(options, *facts);
         auto settings = create_settings(options);
         auto output_file = get_output_file(options);
+        auto format = get_format(options);
         auto graph_file = get_graph_file(options);
 
         // Move the options into the lambda capture
@@ -183,6 +186,7 @@ namespace puppet { namespace options { namespace commands {
                 node_name = rvalue_cast(node_name),
                 settings = rvalue_cast(settings),
                 output_file = rvalue_cast(output_file),
+                format,
                 graph_file = rvalue_cast(graph_file),
                 this
             ] () {
@@ -197,6 +201,10 @@ namespace puppet { namespace options { namespace commands {
                     environment->dispatcher().add_builtin_operators();
 
                     compiler::node node{ logger, node_name, rvalue_cast(environment), facts };
+
+                    // Bound regular expression matches for the session as a compilation does
+                    utility::regex::scoped_timeout timeout{ node.environment().regex_timeout() };
+
                     compiler::catalog catalog{ node.name(), node.environment().name() };
                     auto context = node.create_context(catalog);
 
@@ -222,12 +230,12 @@ namespace puppet { namespace options { namespace commands {
                         catalog.detect_cycles();
 
                         if (!output_file.empty()) {
-                            ofstream output{ output_file };
+                            ofstream output{ output_file, format == catalog_format::msgpack ? (ios_base::out | ios_base::binary) : ios_base::out };
                             if (!output) {
                                 LOG(error, "cannot open '%1%' for writing.", output_file);
                             } else {
                                 LOG(notice, "writing catalog to '%1%'.", output_file);
-                                catalog.write(output);
+                                catalog.write(output, format);
                             }
                         }
                     } catch (evaluation_exception const& ex) {
@@ -35,7 +35,7 @@ namespace puppet { namespace runtime { namespace types {
         if (_strings.empty()) {
             return true;
         }
-        return std::find(_strings.begin(), _strings.end(), *ptr) != _strings.end();
+        return _strings.count(*ptr) > 0;
     }
 
     bool enumeration::is_assignable(values::type const& other, recursion_guard& guard) const
@@ -50,7 +50,7 @@ namespace puppet { namespace runtime { namespace types {
             }
             // All of the other's strings must be in this enumeration
             for (auto& string : enumeration->_strings) {
-                if (std::find(_strings.begin(), _strings.end(), string) == _strings.end()) {
+                if (_strings.count(string) == 0) {
                     return false;
                 }
             }
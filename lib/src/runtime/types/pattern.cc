@@ -1,6 +1,7 @@
 #include <puppet/runtime/values/value.hpp>
 #include <puppet/cast.hpp>
 #include <boost/functional/hash.hpp>
+#include <numeric>
 
 using namespace std;
 
@@ -39,8 +40,22 @@ namespace puppet { namespace runtime { namespace types {
             return true;
         }
 
-        // Check for a matching pattern
-        for (auto const& regex : _patterns) {
+        // A single pattern is searched directly
+        if (_patterns.size() == 1) {
+            auto const& regex = _patterns.front();
+            return regex.pattern().empty() || regex.search(*ptr);
+        }
+
+        if (!_matcher_built) {
+            build_matcher();
+        }
+
+        // Search with the combined matcher and then with any patterns that could not be combined
+        if (_matcher && _matcher->search(*ptr)) {
+            return true;
+        }
+        for (auto index : _uncombined) {
+            auto const& regex = _patterns[index];
             if (regex.pattern().empty() || regex.search(*ptr)) {
                 return true;
             }
@@ -48,6 +63,44 @@ namespace puppet { namespace runtime { namespace types {
         return false;
     }
 
+    void pattern::build_matcher() const
+    {
+        _matcher.reset();
+        _uncombined.clear();
+        _matcher_built = true;
+
+        // Combine the patterns into alternatives of a single regex; an empty pattern matches everything
+        std::string expression;
+        size_t combined = 0;
+        for (size_t i = 0; i < _patterns.size(); ++i) {
+            auto const& pattern = _patterns[i].pattern();
+            if (pattern.empty() || !utility::regex::can_combine(pattern)) {
+                _uncombined.push_back(i);
+                continue;
+            }
+            if (!expression.empty()) {
+                expression += '|';
+            }
+            expression += "(?:";
+            expression += pattern;
+            expression += ')';
+            ++combined;
+        }
+        if (combined < 2) {
+            _uncombined.resize(_patterns.size());
+            iota(_uncombined.begin(), _uncombined.end(), 0);
+            return;
+        }
+
+        try {
+            _matcher = make_shared<utility::regex const>(expression);
+        } catch (utility::regex_exception const&) {
+            // Fall back to searching with each regex
+            _uncombined.resize(_patterns.size());
+            iota(_uncombined.begin(), _uncombined.end(), 0);
+        }
+    }
+
     bool pattern::is_assignable(values::type const& other, recursion_guard& guard) const
     {
         if (boost::get<types::string>(&other)) {
@@ -19,6 +19,7 @@ namespace puppet { namespace runtime { namespace types {
                 throw runtime_error("a non-null value for schema was expected.");
             }
         }
+        update_keys();
     }
 
     structure::structure(structure const& other)
@@ -29,16 +30,19 @@ namespace puppet { namespace runtime { namespace types {
             auto value = make_unique<values::type>(*kvp.second);
             _schema.emplace_back(make_pair(rvalue_cast(key), rvalue_cast(value)));
         }
+        update_keys();
     }
 
     structure& structure::operator=(structure const& other)
     {
+        _schema.clear();
         _schema.reserve(other._schema.size());
         for (auto const& kvp : other._schema) {
             auto key = make_unique<values::type>(*kvp.first);
             auto value = make_unique<values::type>(*kvp.second);
             _schema.emplace_back(make_pair(rvalue_cast(key), rvalue_cast(value)));
         }
+        update_keys();
         return *this;
     }
 
@@ -47,6 +51,16 @@ namespace puppet { namespace runtime { namespace types {
         return _schema;
     }
 
+    void structure::update_keys()
+    {
+        // Create the key values once so that instance checks don't create a string value for every key
+        _keys.clear();
+        _keys.reserve(_schema.size());
+        for (auto const& kvp : _schema) {
+            _keys.emplace_back(make_unique<values::value>(to_key(*kvp.first)));
+        }
+    }
+
     char const* structure::name()
     {
         return "Struct";
@@ -76,8 +90,9 @@ namespace puppet { namespace runtime { namespace types {
 
         // Go through the schema and ensure the hash conforms
         size_t count = 0;
-        for (auto const& kvp : _schema) {
-            auto value = ptr->get(to_key(*kvp.first));
+        for (size_t i = 0; i < _schema.size(); ++i) {
+            auto const& kvp = _schema[i];
+            auto value = ptr->get(*_keys[i]);
             if (!value) {
                 // Check to see if the key is entirely optional
                 if (boost::get<types::optional>(kvp.first.get())) {
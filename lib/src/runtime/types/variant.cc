@@ -19,9 +19,11 @@ namespace puppet { namespace runtime { namespace types {
                 _types.emplace_back(rvalue_cast(type));
             }
         }
+        update_kinds();
     }
 
-    variant::variant(variant const& other)
+    variant::variant(variant const& other) :
+        _kinds(other._kinds)
     {
         _types.reserve(other._types.size());
         for (auto const& element : other._types) {
@@ -31,10 +33,12 @@ namespace puppet { namespace runtime { namespace types {
 
     variant& variant::operator=(variant const& other)
     {
+        _types.clear();
         _types.reserve(other._types.size());
         for (auto const& element : other._types) {
             _types.emplace_back(new values::type(*element));
         }
+        _kinds = other._kinds;
         return *this;
     }
 
@@ -43,6 +47,15 @@ namespace puppet { namespace runtime { namespace types {
         return _types;
     }
 
+    void variant::update_kinds()
+    {
+        _kinds.clear();
+        _kinds.reserve(_types.size());
+        for (auto const& type : _types) {
+            _kinds.push_back(type->instance_kinds());
+        }
+    }
+
     char const* variant::name()
     {
         return "Variant";
@@ -67,9 +80,10 @@ namespace puppet { namespace runtime { namespace types {
 
     bool variant::is_instance(values::value const& value, recursion_guard& guard) const
     {
-        // Go through each type and ensure one matches
-        for (auto const& type : _types) {
-            if (type->is_instance(value, guard)) {
+        // Go through each type and ensure one matches, skipping types that can't match this kind of value
+        auto kind = values::type::kind(value);
+        for (size_t i = 0; i < _types.size(); ++i) {
+            if ((_kinds[i] & kind) && _types[i]->is_instance(value, guard)) {
                 return true;
             }
         }
@@ -17,12 +17,67 @@ namespace puppet { namespace runtime { namespace values {
         return _pattern;
     }
 
-    bool regex::match(compiler::evaluation::context& context, std::string const& value) const
+    bool regex::match(compiler::evaluation::context& context, values::value const& value) const
     {
+        auto string = value.as<std::string>();
+        if (!string) {
+            return false;
+        }
+
+        // Share a variable's value with the match scope
+        if (auto variable = boost::get<values::variable>(&value)) {
+            return match_shared(context, variable->shared_value());
+        }
+
+        // A match with a timeout needs a shared subject, so copy the string before the match rather than after it
+        if (utility::regex::timeout().count() > 0) {
+            return match_shared(context, make_shared<values::value const>(*string));
+        }
+
+        utility::regex::regions regions;
+        bool result = _pattern.empty() || search(*string, &regions);
+        if (result) {
+            // Copy the string into the match scope
+            context.set(make_shared<values::value const>(*string), regions);
+        }
+        return result;
+    }
+
+    bool regex::match(compiler::evaluation::context& context, values::value&& value) const
+    {
+        auto string = value.as<std::string>();
+        if (!string) {
+            return false;
+        }
+
+        // Share a variable's value with the match scope
+        if (auto variable = boost::get<values::variable>(&value)) {
+            return match_shared(context, variable->shared_value());
+        }
+
+        // A match with a timeout needs a shared subject, so move the value before the match rather than after it
+        if (utility::regex::timeout().count() > 0) {
+            return match_shared(context, make_shared<values::value const>(rvalue_cast(value)));
+        }
+
+        utility::regex::regions regions;
+        bool result = _pattern.empty() || search(*string, &regions);
+        if (result) {
+            // Move the value into the match scope
+            context.set(make_shared<values::value const>(rvalue_cast(value)), regions);
+        }
+        return result;
+    }
+
+    bool regex::match_shared(compiler::evaluation::context& context, shared_ptr<values::value const> value) const
+    {
+        // Search the string through the shared value so that a match with a timeout does not copy it
+        shared_ptr<std::string const> string{ value, value->as<std::string>() };
+
         utility::regex::regions regions;
-        bool result = _pattern.empty() || search(value, &regions);
+        bool result = _pattern.empty() || search(string, &regions);
         if (result) {
-            context.set(regions.substrings(value));
+            context.set(rvalue_cast(value), regions);
         }
         return result;
     }
@@ -0,0 +1,130 @@
+#include <puppet/runtime/values/string_value.hpp>
+#include <puppet/unicode/string.hpp>
+#include <puppet/cast.hpp>
+
+using namespace std;
+
+namespace puppet { namespace runtime { namespace values {
+
+    // Each of these flags is set after the metadata it describes has been stored
+    static uint8_t const INVARIANT_COMPUTED = 1;
+    static uint8_t const INVARIANT          = 2;
+    static uint8_t const GRAPHEMES_COMPUTED = 4;
+    static uint8_t const HASH_COMPUTED      = 8;
+
+    string_value::string_value() :
+        _flags(0),
+        _graphemes(0),
+        _hash(0)
+    {
+    }
+
+    string_value::string_value(std::string const& value) :
+        std::string(value),
+        _flags(0),
+        _graphemes(0),
+        _hash(0)
+    {
+    }
+
+    string_value::string_value(std::string&& value) noexcept :
+        std::string(rvalue_cast(value)),
+        _flags(0),
+        _graphemes(0),
+        _hash(0)
+    {
+    }
+
+    string_value::string_value(string_value const& other) :
+        std::string(other),
+        _flags(0),
+        _graphemes(0),
+        _hash(0)
+    {
+        copy_metadata(other);
+    }
+
+    string_value::string_value(string_value&& other) noexcept :
+        std::string(rvalue_cast(static_cast<std::string&>(other))),
+        _flags(0),
+        _graphemes(0),
+        _hash(0)
+    {
+        copy_metadata(other);
+        other._flags.store(0, memory_order_relaxed);
+    }
+
+    string_value& string_value::operator=(string_value const& other)
+    {
+        if (this != &other) {
+            std::string::operator=(other);
+            copy_metadata(other);
+        }
+        return *this;
+    }
+
+    string_value& string_value::operator=(string_value&& other) noexcept
+    {
+        if (this != &other) {
+            std::string::operator=(rvalue_cast(static_cast<std::string&>(other)));
+            copy_metadata(other);
+            other._flags.store(0, memory_order_relaxed);
+        }
+        return *this;
+    }
+
+    bool string_value::invariant() const
+    {
+        auto flags = _flags.load(memory_order_acquire);
+        if (!(flags & INVARIANT_COMPUTED)) {
+            flags = INVARIANT_COMPUTED | (unicode::invariant_length(data(), size()) == size() ? INVARIANT : 0);
+            _flags.fetch_or(flags, memory_order_release);
+        }
+        return (flags & INVARIANT) != 0;
+    }
+
+    size_t string_value::graphemes() const
+    {
+        if (_flags.load(memory_order_acquire) & GRAPHEMES_COMPUTED) {
+            return _graphemes.load(memory_order_relaxed);
+        }
+
+        // Only strings with non-invariant code units need to be validated and segmented
+        size_t graphemes = invariant() ? size() : unicode::string{ *this }.graphemes();
+        _graphemes.store(graphemes, memory_order_relaxed);
+        _flags.fetch_or(GRAPHEMES_COMPUTED, memory_order_release);
+        return graphemes;
+    }
+
+    size_t string_value::hash() const
+    {
+        if (_flags.load(memory_order_acquire) & HASH_COMPUTED) {
+            return _hash.load(memory_order_relaxed);
+        }
+
+        auto hash = unicode::hash_value(unicode::string{ *this, graphemes() });
+        _hash.store(hash, memory_order_relaxed);
+        _flags.fetch_or(HASH_COMPUTED, memory_order_release);
+        return hash;
+    }
+
+    std::string string_value::release()
+    {
+        _flags.store(0, memory_order_relaxed);
+        return rvalue_cast(static_cast<std::string&>(*this));
+    }
+
+    void string_value::copy_metadata(string_value const& other)
+    {
+        auto flags = other._flags.load(memory_order_acquire);
+        _graphemes.store(other._graphemes.load(memory_order_relaxed), memory_order_relaxed);
+        _hash.store(other._hash.load(memory_order_relaxed), memory_order_relaxed);
+        _flags.store(flags, memory_order_relaxed);
+    }
+
+    size_t hash_value(string_value const& value)
+    {
+        return value.hash();
+    }
+
+}}}  // namespace puppet::runtime::values
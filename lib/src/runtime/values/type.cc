@@ -3,6 +3,10 @@
 #include <puppet/compiler/evaluation/evaluator.hpp>
 #include <puppet/compiler/exceptions.hpp>
 #include <boost/format.hpp>
+#include <boost/mpl/find.hpp>
+#include <boost/mpl/distance.hpp>
+#include <boost/mpl/begin.hpp>
+#include <boost/mpl/end.hpp>
 
 using namespace std;
 using namespace puppet::compiler;
@@ -81,6 +85,128 @@ namespace puppet { namespace runtime { namespace values {
         return boost::apply_visitor(is_instance_visitor{ value, guard }, _value);
     }
 
+    template <typename T>
+    static uint32_t kind_of()
+    {
+        using value_types = value_base::types;
+        using position = typename boost::mpl::find<value_types, typename stored_type<T>::type>::type;
+        static_assert(!std::is_same<position, typename boost::mpl::end<value_types>::type>::value, "expected a type stored in the value variant.");
+        return 1u << boost::mpl::distance<typename boost::mpl::begin<value_types>::type, position>::value;
+    }
+
+    struct instance_kinds_visitor : boost::static_visitor<uint32_t>
+    {
+        result_type operator()(types::integer const&) const
+        {
+            return kind_of<int64_t>();
+        }
+
+        result_type operator()(types::floating const&) const
+        {
+            return kind_of<double>();
+        }
+
+        result_type operator()(types::numeric const&) const
+        {
+            return kind_of<int64_t>() | kind_of<double>();
+        }
+
+        result_type operator()(types::boolean const&) const
+        {
+            return kind_of<bool>();
+        }
+
+        result_type operator()(types::string const&) const
+        {
+            return kind_of<std::string>();
+        }
+
+        result_type operator()(types::enumeration const&) const
+        {
+            return kind_of<std::string>();
+        }
+
+        result_type operator()(types::pattern const&) const
+        {
+            return kind_of<std::string>();
+        }
+
+        result_type operator()(types::regexp const&) const
+        {
+            return kind_of<values::regex>();
+        }
+
+        result_type operator()(types::type const&) const
+        {
+            return kind_of<values::type>();
+        }
+
+        result_type operator()(types::array const&) const
+        {
+            return kind_of<values::array>();
+        }
+
+        result_type operator()(types::tuple const&) const
+        {
+            return kind_of<values::array>();
+        }
+
+        result_type operator()(types::hash const&) const
+        {
+            return kind_of<values::hash>();
+        }
+
+        result_type operator()(types::structure const&) const
+        {
+            return kind_of<values::hash>();
+        }
+
+        result_type operator()(types::undef const&) const
+        {
+            return kind_of<values::undef>();
+        }
+
+        result_type operator()(types::defaulted const&) const
+        {
+            return kind_of<values::defaulted>();
+        }
+
+        result_type operator()(types::optional const& type) const
+        {
+            return kind_of<values::undef>() | (type.type() ? type.type()->instance_kinds() : 0);
+        }
+
+        result_type operator()(types::variant const& type) const
+        {
+            uint32_t kinds = 0;
+            for (auto const& member : type.types()) {
+                kinds |= member->instance_kinds();
+            }
+            return kinds;
+        }
+
+        template <typename T>
+        result_type operator()(T const&) const
+        {
+            // Aliases may not be resolved yet and other types may match any kind of value
+            return ~0u;
+        }
+    };
+
+    uint32_t type::instance_kinds() const
+    {
+        return boost::apply_visitor(instance_kinds_visitor{}, _value);
+    }
+
+    uint32_t type::kind(values::value const& value)
+    {
+        values::value const* current = &value;
+        while (auto variable = boost::get<values::variable>(current)) {
+            current = &variable->value();
+        }
+        return 1u << current->which();
+    }
+
     struct is_assignable_visitor : boost::static_visitor<bool>
     {
         is_assignable_visitor(values::type const& type, types::recursion_guard& guard) :
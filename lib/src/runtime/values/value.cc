@@ -21,8 +21,18 @@ namespace puppet { namespace runtime { namespace values {
     {
     }
 
+    value::value(std::string const& string) :
+        value_base(string_value{ string })
+    {
+    }
+
+    value::value(std::string&& string) noexcept :
+        value_base(string_value{ rvalue_cast(string) })
+    {
+    }
+
     value::value(char const* string) :
-        value_base(std::string(string))
+        value_base(string_value{ string })
     {
     }
 
@@ -34,7 +44,19 @@ namespace puppet { namespace runtime { namespace values {
 
     value& value::operator=(char const* string)
     {
-        value_base::operator=(std::string(string));
+        value_base::operator=(string_value{ string });
+        return *this;
+    }
+
+    value& value::operator=(std::string const& string)
+    {
+        value_base::operator=(string_value{ string });
+        return *this;
+    }
+
+    value& value::operator=(std::string&& string)
+    {
+        value_base::operator=(string_value{ rvalue_cast(string) });
         return *this;
     }
 
@@ -98,10 +120,7 @@ namespace puppet { namespace runtime { namespace values {
             return true;
         }
         if (auto regex = as<values::regex>()) {
-            if (auto string = other.as<std::string>()) {
-                return regex->match(context, *string);
-            }
-            return false;
+            return regex->match(context, other);
         }
         if (auto array = as<values::array>()) {
             if (auto other_array = other.as<values::array>()) {
@@ -169,13 +188,10 @@ namespace puppet { namespace runtime { namespace values {
             return types::boolean{};
         }
 
-        result_type operator()(string const& value)
+        result_type operator()(string_value const& value)
         {
-            unicode::string string{ value };
-            return types::string{
-                static_cast<int64_t>(string.graphemes()),
-                static_cast<int64_t>(string.graphemes())
-            };
+            auto graphemes = static_cast<int64_t>(value.graphemes());
+            return types::string{ graphemes, graphemes };
         }
 
         result_type operator()(values::regex const& value)
@@ -586,15 +602,31 @@ namespace puppet { namespace runtime { namespace values {
         return boost::apply_visitor(value_printer(os), val);
     }
 
-    bool equality_visitor::operator()(std::string const& left, std::string const& right) const
+    void append(std::string& buffer, value const& val)
+    {
+        // Append common scalars directly; everything else is formatted with the value's stream insertion operator
+        if (auto ptr = val.as<std::string>()) {
+            buffer += *ptr;
+        } else if (auto ptr = val.as<int64_t>()) {
+            buffer += to_string(*ptr);
+        } else if (auto ptr = val.as<bool>()) {
+            buffer += *ptr ? "true" : "false";
+        } else if (!val.is_undef()) {
+            ostringstream os;
+            os << val;
+            buffer += os.str();
+        }
+    }
+
+    bool equality_visitor::operator()(string_value const& left, string_value const& right) const
     {
-        // Build the unicode string depending on which is shorter (faster "invariant" check)
         // Note: this is not a case insensitive check
         // String equality is case sensitive; Puppet's binary '==' operator is case insensitive
-        if (left.size() < right.size()) {
-            return unicode::string{ left } == right;
+        // If either string is invariant, compare by code unit (see unicode::string's equality operators)
+        if (left.invariant() || right.invariant()) {
+            return static_cast<std::string const&>(left) == static_cast<std::string const&>(right);
         }
-        return unicode::string{ right } == left;
+        return unicode::string{ left, left.graphemes() } == unicode::string{ right, right.graphemes() };
     }
 
     bool operator==(value const& left, value const& right)
@@ -609,10 +641,9 @@ namespace puppet { namespace runtime { namespace values {
 
     size_t hash_value(values::value const& value)
     {
-        // If a string, hash using unicode::string to handle Unicode normalization
-        if (auto ptr = value.as<std::string>()) {
-            unicode::string string{ *ptr };
-            return hash_value(string);
+        // If a string, use the string's hash (computed as a unicode::string to handle Unicode normalization)
+        if (auto ptr = value.as<string_value>()) {
+            return ptr->hash();
         }
         return hash_value(static_cast<value_base const&>(value));
     }
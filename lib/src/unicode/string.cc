@@ -8,11 +8,93 @@
 #include <unicode/ucasemap.h>
 #include <unicode/utypes.h>
 #include <unicode/ubrk.h>
+#include <unicode/uset.h>
+#include <algorithm>
+#include <numeric>
+#include <array>
+#include <cstring>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
 
 using namespace std;
 
 namespace puppet { namespace unicode {
 
+    size_t invariant_length(char const* data, size_t length) noexcept
+    {
+        size_t i = 0;
+
+        // Check 32 or 16 code units at a time for any with the high bit set
+        // When a block contains a non-invariant code unit, the scalar loop below finds its exact position
+#if defined(__AVX2__)
+        for (; i + 32 <= length; i += 32) {
+            if (_mm256_movemask_epi8(_mm256_loadu_si256(reinterpret_cast<__m256i const*>(data + i)))) {
+                break;
+            }
+        }
+#endif
+#if defined(__SSE2__) || defined(_M_X64)
+        for (; i + 16 <= length; i += 16) {
+            if (_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<__m128i const*>(data + i)))) {
+                break;
+            }
+        }
+#else
+        for (; i + sizeof(uint64_t) <= length; i += sizeof(uint64_t)) {
+            uint64_t word;
+            memcpy(&word, data + i, sizeof(word));
+            if (word & UINT64_C(0x8080808080808080)) {
+                break;
+            }
+        }
+#endif
+        for (; i < length; ++i) {
+            if (static_cast<unsigned char>(data[i]) > 0x7f) {
+                break;
+            }
+        }
+        return i;
+    }
+
+    static size_t common_prefix_length(char const* left, char const* right, size_t length) noexcept
+    {
+        size_t i = 0;
+
+        // Compare 32 or 16 code units at a time; the scalar loop below finds the exact position of a difference
+#if defined(__AVX2__)
+        for (; i + 32 <= length; i += 32) {
+            auto equal = _mm256_cmpeq_epi8(
+                _mm256_loadu_si256(reinterpret_cast<__m256i const*>(left + i)),
+                _mm256_loadu_si256(reinterpret_cast<__m256i const*>(right + i))
+            );
+            if (static_cast<uint32_t>(_mm256_movemask_epi8(equal)) != 0xFFFFFFFFu) {
+                break;
+            }
+        }
+#endif
+#if defined(__SSE2__) || defined(_M_X64)
+        for (; i + 16 <= length; i += 16) {
+            auto equal = _mm_cmpeq_epi8(
+                _mm_loadu_si128(reinterpret_cast<__m128i const*>(left + i)),
+                _mm_loadu_si128(reinterpret_cast<__m128i const*>(right + i))
+            );
+            if (_mm_movemask_epi8(equal) != 0xFFFF) {
+                break;
+            }
+        }
+#endif
+        for (; i < length; ++i) {
+            if (left[i] != right[i]) {
+                break;
+            }
+        }
+        return i;
+    }
+
     struct posix_locale_helper
     {
         posix_locale_helper()
@@ -73,6 +155,8 @@ namespace puppet { namespace unicode {
                     ).str()
                 );
             }
+
+            rank_invariants();
         }
 
         ~collator()
@@ -81,6 +165,19 @@ namespace puppet { namespace unicode {
         }
 
         int compare(char const* left, int64_t left_size, char const* right, int64_t right_size) const
+        {
+            // Compare invariant strings without ICU when the collator orders invariant code units one at a time
+            if (_ranked) {
+                size_t left_length = left_size < 0 ? strlen(left) : static_cast<size_t>(left_size);
+                size_t right_length = right_size < 0 ? strlen(right) : static_cast<size_t>(right_size);
+                if (invariant_length(left, left_length) == left_length && invariant_length(right, right_length) == right_length) {
+                    return compare_invariant(left, left_length, right, right_length);
+                }
+            }
+            return compare_icu(left, left_size, right, right_size);
+        }
+
+        int compare_icu(char const* left, int64_t left_size, char const* right, int64_t right_size) const
         {
             UErrorCode status = U_ZERO_ERROR;
             auto result = ucol_strcollUTF8(_collator, left, left_size, right, right_size, &status);
@@ -144,7 +241,95 @@ namespace puppet { namespace unicode {
         }
 
      private:
-         UCollator* _collator = nullptr;
+        int compare_invariant(char const* left, size_t left_size, char const* right, size_t right_size) const
+        {
+            size_t i = 0;
+            size_t j = 0;
+            while (true) {
+                // Skip over identical code units
+                auto count = common_prefix_length(left + i, right + j, min(left_size - i, right_size - j));
+                i += count;
+                j += count;
+
+                // Skip over ignorable code units
+                while (i < left_size && _ranks[static_cast<unsigned char>(left[i])] == 0) {
+                    ++i;
+                }
+                while (j < right_size && _ranks[static_cast<unsigned char>(right[j])] == 0) {
+                    ++j;
+                }
+
+                if (i == left_size || j == right_size) {
+                    if (i == left_size) {
+                        return j == right_size ? 0 : -1;
+                    }
+                    return 1;
+                }
+
+                // Code units that differ may still have the same rank (e.g. case differences when ignoring case)
+                auto left_rank = _ranks[static_cast<unsigned char>(left[i])];
+                auto right_rank = _ranks[static_cast<unsigned char>(right[j])];
+                if (left_rank != right_rank) {
+                    return left_rank < right_rank ? -1 : 1;
+                }
+                ++i;
+                ++j;
+            }
+        }
+
+        void rank_invariants()
+        {
+            // Sort the invariant code units using the collator
+            array<char, 0x80> units;
+            iota(units.begin(), units.end(), 0);
+            stable_sort(units.begin(), units.end(), [&](char left, char right) {
+                return compare_icu(&left, 1, &right, 1) < 0;
+            });
+
+            // Rank the code units in collation order; ignorable code units (equal to an empty string) have a rank of zero
+            uint8_t rank = 0;
+            for (size_t i = 0; i < units.size(); ++i) {
+                if (i == 0 ? compare_icu(&units[i], 1, "", 0) != 0 : compare_icu(&units[i - 1], 1, &units[i], 1) != 0) {
+                    ++rank;
+                }
+                _ranks[static_cast<unsigned char>(units[i])] = rank;
+            }
+
+            // Ranks can only be compared one code unit at a time if the collator has no contractions or expansions of invariant code units
+            UErrorCode status = U_ZERO_ERROR;
+            auto contractions = uset_openEmpty();
+            auto expansions = uset_openEmpty();
+            auto invariants = uset_open(0, 0x7f);
+            ucol_getContractionsAndExpansions(_collator, contractions, expansions, true, &status);
+            bool ranked = U_SUCCESS(status) && !uset_containsSome(expansions, invariants);
+            for (int32_t i = 0; ranked && i < uset_getItemCount(contractions); ++i) {
+                UChar32 start, end;
+                UChar contraction[64];
+                status = U_ZERO_ERROR;
+                auto length = uset_getItem(contractions, i, &start, &end, contraction, sizeof(contraction) / sizeof(contraction[0]), &status);
+                ranked = U_SUCCESS(status) && (length == 0 || !all_of(contraction, contraction + length, [](UChar c) { return c < 0x80; }));
+            }
+            uset_close(invariants);
+            uset_close(expansions);
+            uset_close(contractions);
+
+            // A difference in rank must outweigh any difference that follows it (i.e. ranks must differ at the primary level)
+            // This isn't the case for a case sensitive collator, where case differences are only considered after everything else
+            auto lowest = find_if(units.begin(), units.end(), [&](char unit) { return _ranks[static_cast<unsigned char>(unit)] != 0; });
+            for (auto it = lowest; ranked && it != units.end() && (it + 1) != units.end(); ++it) {
+                if (_ranks[static_cast<unsigned char>(*it)] == _ranks[static_cast<unsigned char>(*(it + 1))]) {
+                    continue;
+                }
+                char left[] = { *it, units.back() };
+                char right[] = { *(it + 1), *lowest };
+                ranked = compare_icu(left, 2, right, 2) < 0;
+            }
+            _ranked = ranked;
+        }
+
+        UCollator* _collator = nullptr;
+        array<uint8_t, 0x80> _ranks;
+        bool _ranked = false;
     };
 
     struct case_map
@@ -485,6 +670,13 @@ namespace puppet { namespace unicode {
         count_graphemes();
     }
 
+    string::string(std::string const& s, size_t graphemes) :
+        _data(s.data()),
+        _graphemes(graphemes),
+        _units(s.size())
+    {
+    }
+
     string::string(char const* s) :
         _data(s),
         _graphemes(0),
@@ -952,12 +1144,17 @@ namespace puppet { namespace unicode {
 
     void string::count_graphemes()
     {
-        // Iterate the string as code points to determine if the string contains only invariant code units
+        // Determine the length of null terminated strings
+        if (_units == npos) {
+            _units = strlen(_data);
+        }
+
+        // Skip runs of invariant code units with the vectorized scan; only the code points in between need to be decoded
         // This also verifies that the string only contains valid UTF-8 data
         bool is_invariant = true;
-        int32_t i = 0;
-        int32_t length = _units == npos ? -1 : _units;
-        while (length == -1 || i < length) {
+        int32_t length = static_cast<int32_t>(_units);
+        int32_t i = static_cast<int32_t>(invariant_length(_data, _units));
+        while (i < length) {
             UChar32 code_point = 0;
             U8_NEXT(_data, i, length, code_point);
             if (code_point < 0) {
@@ -966,11 +1163,7 @@ namespace puppet { namespace unicode {
             if (code_point > 0x7f) {
                 is_invariant = false;
             }
-            // Check for null terminated strings
-            if (length == -1 && code_point == 0) {
-                _units = i - 1;
-                break;
-            }
+            i += static_cast<int32_t>(invariant_length(_data + i, _units - i));
         }
 
         if (is_invariant) {
@@ -1,9 +1,36 @@
 #include <puppet/utility/filesystem/helpers.hpp>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
 
 using namespace std;
 
 namespace puppet { namespace utility { namespace filesystem {
 
+    struct file_descriptor
+    {
+        explicit file_descriptor(int descriptor) :
+            _descriptor(descriptor)
+        {
+        }
+
+        ~file_descriptor()
+        {
+            if (_descriptor >= 0) {
+                close(_descriptor);
+            }
+        }
+
+        int get() const
+        {
+            return _descriptor;
+        }
+
+     private:
+        int _descriptor;
+    };
+
     char const* path_separator()
     {
         return ":";
@@ -14,4 +41,41 @@ namespace puppet { namespace utility { namespace filesystem {
         return getenv("HOME");
     }
 
+    bool read_file(string const& path, string& contents)
+    {
+        file_descriptor descriptor{ open(path.c_str(), O_RDONLY | O_CLOEXEC) };
+        if (descriptor.get() < 0) {
+            return false;
+        }
+
+        struct stat status;
+        if (fstat(descriptor.get(), &status) != 0 || S_ISDIR(status.st_mode)) {
+            return false;
+        }
+
+        // Read into a buffer sized from the file's status; keep reading in case the file is larger than reported
+        auto size = S_ISREG(status.st_mode) ? static_cast<size_t>(status.st_size) : 0;
+        contents.clear();
+        contents.resize(size > 0 ? size : 4096);
+        size_t offset = 0;
+        while (true) {
+            if (offset == contents.size()) {
+                contents.resize(contents.size() * 2);
+            }
+            auto count = read(descriptor.get(), &contents[offset], contents.size() - offset);
+            if (count < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return false;
+            }
+            if (count == 0) {
+                break;
+            }
+            offset += static_cast<size_t>(count);
+        }
+        contents.resize(offset);
+        return true;
+    }
+
 }}}  // namespace puppet::utility::filesystem
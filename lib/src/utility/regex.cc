@@ -1,9 +1,96 @@
 #include <puppet/utility/regex.hpp>
+#include <puppet/cast.hpp>
+#include <boost/format.hpp>
+#include <algorithm>
+#include <cctype>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
 
 using namespace std;
 
 namespace puppet { namespace utility {
 
+    // Runs timed matches on a capped set of worker threads that are reused across matches
+    // Onigmo cannot interrupt a match, so a match that exceeds its timeout keeps its worker busy until it completes
+    // A match that is still queued when its timeout expires is cancelled without running
+    struct match_pool
+    {
+        struct job
+        {
+            function<void()> run;
+            condition_variable signal;
+            bool started = false;
+            bool done = false;
+        };
+
+        static match_pool& instance()
+        {
+            // The pool is never destroyed as a worker may still be running an abandoned match when the process exits
+            static match_pool* pool = new match_pool(max<size_t>(2, thread::hardware_concurrency()));
+            return *pool;
+        }
+
+        bool execute(shared_ptr<job> const& job, chrono::milliseconds timeout)
+        {
+            unique_lock<mutex> lock(_lock);
+            _queue.push_back(job);
+
+            // Start another worker if there are more queued jobs than idle workers and the pool is not at capacity
+            if (_queue.size() > _idle && _workers.size() < _capacity) {
+                _workers.emplace_back(&match_pool::run, this);
+            }
+            _signal.notify_one();
+
+            if (job->signal.wait_for(lock, timeout, [&]() { return job->done; })) {
+                return true;
+            }
+
+            // Cancel the job if a worker has not yet started it
+            if (!job->started) {
+                _queue.erase(find(_queue.begin(), _queue.end(), job));
+            }
+            return false;
+        }
+
+     private:
+        explicit match_pool(size_t capacity) :
+            _capacity(capacity),
+            _idle(0)
+        {
+        }
+
+        void run()
+        {
+            unique_lock<mutex> lock(_lock);
+            while (true) {
+                ++_idle;
+                _signal.wait(lock, [&]() { return !_queue.empty(); });
+                --_idle;
+
+                auto job = rvalue_cast(_queue.front());
+                _queue.pop_front();
+                job->started = true;
+                lock.unlock();
+                job->run();
+                lock.lock();
+                job->done = true;
+                job->signal.notify_all();
+            }
+        }
+
+        mutex _lock;
+        condition_variable _signal;
+        deque<shared_ptr<job>> _queue;
+        vector<thread> _workers;
+        size_t _capacity;
+        size_t _idle;
+    };
+
+    static thread_local chrono::milliseconds current_timeout{ 0 };
+
     regex::regions::regions()
     {
         onig_region_init(&_data);
@@ -126,49 +213,167 @@ namespace puppet { namespace utility {
 
     bool regex::match(string const& str, regex::regions* regions) const
     {
-        auto start = str.data();
+        return match_result(execute(str, nullptr, 0, regions, false), str.size(), regions);
+    }
+
+    bool regex::match(shared_ptr<string const> const& str, regex::regions* regions) const
+    {
+        return match_result(execute(*str, str, 0, regions, false), str->size(), regions);
+    }
+
+    bool regex::search(string const& str, regex::regions* regions, size_t offset) const
+    {
+        return search_result(execute(str, nullptr, offset, regions, true), regions);
+    }
+
+    bool regex::search(shared_ptr<string const> const& str, regex::regions* regions, size_t offset) const
+    {
+        return search_result(execute(*str, str, offset, regions, true), regions);
+    }
+
+    bool regex::can_combine(string const& pattern)
+    {
+        // Backreferences, subexpression calls, conditionals and named groups depend on the pattern's own groups
+        // Extended mode is also excluded as a comment would consume the end of the group wrapping the pattern
+        for (size_t i = 0; i + 1 < pattern.size(); ++i) {
+            if (pattern[i] == '\\') {
+                auto next = pattern[++i];
+                if (next == 'k' || next == 'g' || (next >= '1' && next <= '9')) {
+                    return false;
+                }
+                continue;
+            }
+            if (pattern[i] != '(' || pattern[i + 1] != '?' || i + 2 >= pattern.size()) {
+                continue;
+            }
+            auto kind = pattern[i + 2];
+            if (kind == '<') {
+                // Allow lookbehind, but not a named group
+                if (i + 3 >= pattern.size() || (pattern[i + 3] != '=' && pattern[i + 3] != '!')) {
+                    return false;
+                }
+                continue;
+            }
+            if (kind == '\'' || kind == '(') {
+                return false;
+            }
+            // Check for the extended option in an option group (e.g. "(?mx)" or "(?x-i:...)")
+            for (size_t j = i + 2; j < pattern.size() && (isalpha(static_cast<unsigned char>(pattern[j])) || pattern[j] == '-'); ++j) {
+                if (pattern[j] == 'x') {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    regex::scoped_timeout::scoped_timeout(chrono::milliseconds timeout) :
+        _previous(current_timeout)
+    {
+        current_timeout = timeout;
+    }
+
+    regex::scoped_timeout::~scoped_timeout()
+    {
+        current_timeout = _previous;
+    }
+
+    chrono::milliseconds regex::timeout()
+    {
+        return current_timeout;
+    }
+
+    int regex::execute(string const& str, shared_ptr<string const> const& shared, size_t offset, regex::regions* regions, bool search) const
+    {
+        auto timeout = current_timeout;
+        if (timeout.count() > 0) {
+            // The subject must outlive an abandoned match, so copy it only if the caller is not sharing it
+            return execute_with_timeout(shared ? shared : make_shared<string const>(str), offset, regions, search, timeout);
+        }
+
+        auto start = reinterpret_cast<OnigUChar const*>(str.data());
         auto end = start + str.size();
 
-        // Casting away const on _regex; onig_match should internally be thread safe despite not being const-correct
-        auto result = onig_match(
+        // Casting away const on _regex; Onigmo should internally be thread safe despite not being const-correct
+        if (search) {
+            return onig_search(
+                const_cast<regex_t*>(&_wrapper->get()),
+                start,
+                end,
+                start + offset,
+                end,
+                regions ? &regions->_data : nullptr,
+                ONIG_OPTION_NONE
+            );
+        }
+        return onig_match(
             const_cast<regex_t*>(&_wrapper->get()),
-            reinterpret_cast<OnigUChar const*>(start),
-            reinterpret_cast<OnigUChar const*>(end),
-            reinterpret_cast<OnigUChar const*>(start),
+            start,
+            end,
+            start + offset,
             regions ? &regions->_data : nullptr,
             ONIG_OPTION_NONE
         );
+    }
+
+    int regex::execute_with_timeout(shared_ptr<string const> subject, size_t offset, regex::regions* regions, bool search, chrono::milliseconds timeout) const
+    {
+        // The job owns everything it uses as an abandoned match may outlive the caller's regex and regions
+        struct job_state : match_pool::job
+        {
+            job_state(regex const& expression, shared_ptr<string const> subject) :
+                expression(expression),
+                subject(rvalue_cast(subject)),
+                result(ONIG_MISMATCH)
+            {
+            }
+
+            regex expression;
+            shared_ptr<string const> subject;
+            regex::regions regions;
+            int result;
+        };
+        auto job = make_shared<job_state>(*this, rvalue_cast(subject));
+        bool populate = regions != nullptr;
+        auto state = job.get();
+        job->run = [state, offset, populate, search]() {
+            // Run the match without a timeout on the worker thread
+            state->result = state->expression.execute(*state->subject, nullptr, offset, populate ? &state->regions : nullptr, search);
+        };
+
+        if (!match_pool::instance().execute(job, timeout)) {
+            throw regex_exception(
+                (boost::format("the match exceeded the timeout of %1% %2%.") %
+                 timeout.count() %
+                 (timeout.count() != 1 ? "milliseconds" : "millisecond")
+                ).str(),
+                0
+            );
+        }
+        if (regions && job->result >= 0) {
+            onig_region_copy(&regions->_data, &job->regions._data);
+        }
+        return job->result;
+    }
+
+    bool regex::match_result(int result, size_t size, regex::regions* regions)
+    {
+        if (result < 0 && result != ONIG_MISMATCH) {
+            throw_match_error(result);
+        }
         // Check for no match or a match that did not span the entire length of the string
-        if (result == ONIG_MISMATCH || result != (end - start)) {
+        if (result == ONIG_MISMATCH || static_cast<size_t>(result) != size) {
             // Ensure no regions are returned when there is no match
             if (regions) {
                 regions->_data.num_regs = 0;
             }
             return false;
         }
-        if (result < 0) {
-            OnigUChar message[ONIG_MAX_ERROR_MESSAGE_LEN] = {};
-            onig_error_code_to_str(message, result);
-            throw regex_exception(reinterpret_cast<char const*>(message), result);
-        }
         return true;
     }
 
-    bool regex::search(string const& str, regex::regions* regions, size_t offset) const
+    bool regex::search_result(int result, regex::regions* regions)
     {
-        auto start = str.data();
-        auto end = start + str.size();
-
-        // Casting away const on _regex; onig_search should internally be thread safe despite not being const-correct
-        auto result = onig_search(
-            const_cast<regex_t*>(&_wrapper->get()),
-            reinterpret_cast<OnigUChar const*>(start),
-            reinterpret_cast<OnigUChar const*>(end),
-            reinterpret_cast<OnigUChar const*>(start + offset),
-            reinterpret_cast<OnigUChar const*>(end),
-            regions ? &regions->_data : nullptr,
-            ONIG_OPTION_NONE
-        );
         if (result == ONIG_MISMATCH) {
             // Ensure no regions are returned when there is no match
             if (regions) {
@@ -177,13 +382,18 @@ namespace puppet { namespace utility {
             return false;
         }
         if (result < 0) {
-            OnigUChar message[ONIG_MAX_ERROR_MESSAGE_LEN] = {};
-            onig_error_code_to_str(message, result);
-            throw regex_exception(reinterpret_cast<char const*>(message), result);
+            throw_match_error(result);
         }
         return true;
     }
 
+    void regex::throw_match_error(int result)
+    {
+        OnigUChar message[ONIG_MAX_ERROR_MESSAGE_LEN] = {};
+        onig_error_code_to_str(message, result);
+        throw regex_exception(reinterpret_cast<char const*>(message), result);
+    }
+
     regex::wrapper::wrapper()
     {
         memset(&_regex, 0, sizeof(_regex));
@@ -1,6 +1,7 @@
 #include <catch.hpp>
 #include <puppet/compiler/environment.hpp>
 #include <boost/filesystem.hpp>
+#include <fstream>
 
 using namespace std;
 using namespace puppet;
@@ -336,3 +337,95 @@ SCENARIO("environment with user templates", "[environment]")
         }
     }
 }
+
+static void write_file(fs::path const& path, string const& contents)
+{
+    ofstream file{ path.string() };
+    REQUIRE(file);
+    file << contents;
+}
+
+SCENARIO("environment caching templates and files", "[environment]")
+{
+    puppet::logging::console_logger logger;
+
+    fs::path environments_dir = fs::path{FIXTURES_DIR} / "compiler" / "environments";
+
+    compiler::settings settings;
+    settings.set(settings::environment_path, environments_dir.string());
+    settings.set(settings::environment, "evaluation");
+
+    auto environment = puppet::compiler::environment::create(logger, settings);
+
+    auto directory = fs::temp_directory_path() / fs::unique_path();
+    REQUIRE(fs::create_directories(directory));
+    auto path = directory / "template.epp";
+
+    WHEN("importing a template file") {
+        write_file(path, "hello <%= $name %>");
+        auto tree = environment->import_template(logger, path.string());
+        REQUIRE(tree);
+
+        THEN("it should reuse the tree while the file is unchanged") {
+            REQUIRE(environment->import_template(logger, path.string()) == tree);
+        }
+        THEN("it should parse the file again when the file changes") {
+            write_file(path, "goodbye <%= $name %>");
+            auto changed = environment->import_template(logger, path.string());
+            REQUIRE(changed);
+            REQUIRE(changed != tree);
+            REQUIRE(environment->import_template(logger, path.string()) == changed);
+        }
+        THEN("it should not cache a template that fails to parse") {
+            write_file(path, "<%- whoops %->");
+            REQUIRE_THROWS(environment->import_template(logger, path.string()));
+            REQUIRE_THROWS(environment->import_template(logger, path.string()));
+            write_file(path, "fixed <%= $name %>");
+            auto fixed = environment->import_template(logger, path.string());
+            REQUIRE(fixed);
+            REQUIRE(fixed != tree);
+        }
+    }
+    WHEN("importing an inline template") {
+        auto tree = environment->import_inline_template(logger, "hello <%= $name %>", "inline");
+        REQUIRE(tree);
+
+        THEN("it should reuse the tree for the same source") {
+            REQUIRE(environment->import_inline_template(logger, "hello <%= $name %>", "inline") == tree);
+        }
+        THEN("it should parse different source") {
+            REQUIRE(environment->import_inline_template(logger, "goodbye <%= $name %>", "inline") != tree);
+        }
+        THEN("it should not cache a template that fails to parse") {
+            REQUIRE_THROWS(environment->import_inline_template(logger, "<%- whoops %->", "inline"));
+            REQUIRE_THROWS(environment->import_inline_template(logger, "<%- whoops %->", "inline"));
+        }
+    }
+    WHEN("reading a file") {
+        write_file(path, "hello");
+        auto contents = environment->read_file(path.string());
+        REQUIRE(contents);
+        REQUIRE(*contents->as<string>() == "hello");
+
+        THEN("it should reuse the contents while the file is unchanged") {
+            REQUIRE(environment->read_file(path.string()) == contents);
+        }
+        THEN("it should read the file again when the file changes") {
+            write_file(path, "goodbye");
+            auto changed = environment->read_file(path.string());
+            REQUIRE(changed);
+            REQUIRE(*changed->as<string>() == "goodbye");
+        }
+        THEN("it should not cache a missing file") {
+            fs::remove(path);
+            REQUIRE_FALSE(environment->read_file(path.string()));
+            write_file(path, "restored");
+            auto restored = environment->read_file(path.string());
+            REQUIRE(restored);
+            REQUIRE(*restored->as<string>() == "restored");
+        }
+    }
+
+    sys::error_code ec;
+    fs::remove_all(directory, ec);
+}
@@ -0,0 +1,129 @@
+#include <catch.hpp>
+#include <puppet/facts/cache.hpp>
+#include <puppet/facts/json.hpp>
+#include <puppet/cast.hpp>
+#include <boost/filesystem.hpp>
+#include <fstream>
+
+using namespace std;
+using namespace puppet;
+using namespace puppet::runtime;
+namespace fs = boost::filesystem;
+namespace sys = boost::system;
+
+static void write_file(fs::path const& path, string const& contents)
+{
+    ofstream file{ path.string() };
+    REQUIRE(file);
+    file << contents;
+}
+
+static string lookup_string(facts::provider& provider, string const& name)
+{
+    auto value = provider.lookup(name);
+    REQUIRE(value);
+    auto ptr = value->as<string>();
+    REQUIRE(ptr);
+    return *ptr;
+}
+
+SCENARIO("facts cache", "[facts]")
+{
+    auto directory = fs::temp_directory_path() / fs::unique_path();
+    REQUIRE(fs::create_directories(directory));
+    auto path = directory / "facts.json";
+    auto cache_path = directory / "facts.json.cache";
+
+    WHEN("saving and loading facts") {
+        write_file(path, "{}");
+
+        values::array array;
+        array.emplace_back(static_cast<int64_t>(1));
+        array.emplace_back(string{ "Two" });
+        array.emplace_back(values::undef());
+        values::hash hash;
+        hash.set(values::value{ string{ "key" } }, values::value{ rvalue_cast(array) });
+
+        facts::cache::fact_map facts;
+        facts.emplace("undef", make_shared<values::value>(values::undef()));
+        facts.emplace("false", make_shared<values::value>(false));
+        facts.emplace("true", make_shared<values::value>(true));
+        facts.emplace("integer", make_shared<values::value>(static_cast<int64_t>(-42)));
+        facts.emplace("float", make_shared<values::value>(0.25));
+        facts.emplace("string", make_shared<values::value>(string{ "Hello" }));
+        facts.emplace("hash", make_shared<values::value>(rvalue_cast(hash)));
+        facts::cache{ path.string() }.save(facts);
+
+        THEN("the loaded facts should match the saved facts") {
+            facts::cache::fact_map loaded;
+            REQUIRE(facts::cache{ path.string() }.load(loaded));
+            REQUIRE(loaded.size() == facts.size());
+            for (auto const& kvp : facts) {
+                REQUIRE(loaded.count(kvp.first) == 1);
+                REQUIRE(*loaded[kvp.first] == *kvp.second);
+            }
+            REQUIRE(*loaded["string"]->as<string>() == "Hello");
+            auto value = loaded["hash"]->as<values::hash>()->get(values::value{ string{ "key" } });
+            REQUIRE(value);
+            REQUIRE(*(*value->as<values::array>())[1]->as<string>() == "Two");
+        }
+        THEN("the cache should not be loaded when the facts file changes size") {
+            write_file(path, "{ }");
+            facts::cache::fact_map loaded;
+            REQUIRE_FALSE(facts::cache{ path.string() }.load(loaded));
+            REQUIRE(loaded.empty());
+        }
+        THEN("the cache should not be loaded when the facts file has a different modification time") {
+            fs::last_write_time(path, fs::last_write_time(path) - 10);
+            facts::cache::fact_map loaded;
+            REQUIRE_FALSE(facts::cache{ path.string() }.load(loaded));
+        }
+        THEN("the cache should not be loaded when the facts file is missing") {
+            fs::remove(path);
+            facts::cache::fact_map loaded;
+            REQUIRE_FALSE(facts::cache{ path.string() }.load(loaded));
+        }
+        THEN("the cache should not be loaded when it is truncated") {
+            fs::resize_file(cache_path, fs::file_size(cache_path) - 1);
+            facts::cache::fact_map loaded;
+            REQUIRE_FALSE(facts::cache{ path.string() }.load(loaded));
+        }
+    }
+    WHEN("a provider uses the cache") {
+        write_file(path, "{ \"foo\": \"bar\" }");
+        auto modified = fs::last_write_time(path);
+        {
+            facts::json provider{ path.string(), true };
+            REQUIRE(lookup_string(provider, "foo") == "bar");
+        }
+        REQUIRE(fs::exists(cache_path));
+
+        THEN("it should load the facts from the cache while the facts file is unchanged") {
+            // Replace the facts with the same size and modification time; the cached facts should be used
+            write_file(path, "{ \"foo\": \"baz\" }");
+            fs::last_write_time(path, modified);
+            facts::json provider{ path.string(), true };
+            REQUIRE(lookup_string(provider, "foo") == "bar");
+        }
+        THEN("it should parse the facts file again when it changes within the same second") {
+            write_file(path, "{ \"foo\": \"changed\" }");
+            fs::last_write_time(path, modified);
+            facts::json provider{ path.string(), true };
+            REQUIRE(lookup_string(provider, "foo") == "changed");
+
+            // The cache should have been updated
+            facts::cache::fact_map loaded;
+            REQUIRE(facts::cache{ path.string() }.load(loaded));
+            REQUIRE(*loaded["foo"]->as<string>() == "changed");
+        }
+        THEN("it should not use the cache when not requested") {
+            write_file(path, "{ \"foo\": \"baz\" }");
+            fs::last_write_time(path, modified);
+            facts::json provider{ path.string() };
+            REQUIRE(lookup_string(provider, "foo") == "baz");
+        }
+    }
+
+    sys::error_code ec;
+    fs::remove_all(directory, ec);
+}
@@ -0,0 +1,120 @@
+#include <catch.hpp>
+#include <puppet/facts/facter.hpp>
+#include <facter/facts/scalar_value.hpp>
+#include <facter/facts/map_value.hpp>
+#include <puppet/cast.hpp>
+#include <memory>
+#include <vector>
+#include <algorithm>
+
+using namespace std;
+using namespace puppet;
+using namespace puppet::runtime;
+
+// Replaces the system facts with a fixed set of facts
+struct test_facter : facts::facter
+{
+    void add(string const& name, string const& value)
+    {
+        REQUIRE(_collection);
+        _collection->add(name, make_unique<::facter::facts::string_value>(value));
+    }
+
+    size_t initialized = 0;
+
+ protected:
+    void initialize(::facter::facts::collection& collection) override
+    {
+        ++initialized;
+        _collection = &collection;
+
+        collection.add("string", make_unique<::facter::facts::string_value>("hello"));
+        collection.add("integer", make_unique<::facter::facts::integer_value>(42));
+
+        auto map = make_unique<::facter::facts::map_value>();
+        map->add("fqdn", make_unique<::facter::facts::string_value>("foo.example.com"));
+        collection.add("networking", rvalue_cast(map));
+    }
+
+ private:
+    ::facter::facts::collection* _collection = nullptr;
+};
+
+static vector<string> enumerate(facts::provider& provider, bool accessed)
+{
+    vector<string> names;
+    provider.each(accessed, [&](string const& name, shared_ptr<values::value const> const& value) {
+        REQUIRE(value);
+        names.push_back(name);
+        return true;
+    });
+    sort(names.begin(), names.end());
+    return names;
+}
+
+SCENARIO("facter facts", "[facts]")
+{
+    test_facter provider;
+
+    WHEN("the provider is constructed") {
+        THEN("the fact collection should not be initialized") {
+            REQUIRE(provider.initialized == 0);
+        }
+    }
+    WHEN("looking up facts") {
+        auto value = provider.lookup("string");
+        THEN("the collection should be initialized once") {
+            REQUIRE(provider.lookup("integer"));
+            REQUIRE(provider.initialized == 1);
+        }
+        THEN("the fact values should be converted") {
+            REQUIRE(value);
+            REQUIRE(*value->as<string>() == "hello");
+            REQUIRE(*provider.lookup("integer")->as<int64_t>() == 42);
+
+            auto networking = provider.lookup("networking");
+            REQUIRE(networking);
+            auto hash = networking->as<values::hash>();
+            REQUIRE(hash);
+            auto fqdn = hash->get(values::value{ string{ "fqdn" } });
+            REQUIRE(fqdn);
+            REQUIRE(*fqdn->as<string>() == "foo.example.com");
+        }
+        THEN("repeated lookups should return the cached value") {
+            REQUIRE(provider.lookup("string") == value);
+        }
+        THEN("only accessed facts should be enumerated when requested") {
+            REQUIRE(enumerate(provider, true) == vector<string>{ "string" });
+        }
+    }
+    WHEN("looking up a fact that does not exist") {
+        REQUIRE_FALSE(provider.lookup("missing"));
+        THEN("the miss should be cached") {
+            provider.add("missing", "late");
+            REQUIRE_FALSE(provider.lookup("missing"));
+        }
+        THEN("the missing fact should not be enumerated as accessed") {
+            REQUIRE(enumerate(provider, true).empty());
+        }
+        AND_WHEN("enumerating all facts after the fact was added") {
+            provider.add("missing", "late");
+            auto names = enumerate(provider, false);
+            THEN("the cached miss should be replaced with the fact") {
+                REQUIRE(names == (vector<string>{ "integer", "missing", "networking", "string" }));
+                auto value = provider.lookup("missing");
+                REQUIRE(value);
+                REQUIRE(*value->as<string>() == "late");
+            }
+        }
+    }
+    WHEN("enumerating all facts") {
+        auto value = provider.lookup("string");
+        auto names = enumerate(provider, false);
+        THEN("every fact should be enumerated") {
+            REQUIRE(names == (vector<string>{ "integer", "networking", "string" }));
+        }
+        THEN("facts already looked up should keep their cached value") {
+            REQUIRE(provider.lookup("string") == value);
+        }
+    }
+}
@@ -0,0 +1,126 @@
+#include <catch.hpp>
+#include <puppet/facts/json.hpp>
+#include <boost/filesystem.hpp>
+#include <fstream>
+
+using namespace std;
+using namespace puppet;
+using namespace puppet::runtime;
+namespace fs = boost::filesystem;
+namespace sys = boost::system;
+
+static void write_file(fs::path const& path, string const& contents)
+{
+    ofstream file{ path.string() };
+    REQUIRE(file);
+    file << contents;
+}
+
+SCENARIO("JSON fact provider", "[facts]")
+{
+    auto directory = fs::temp_directory_path() / fs::unique_path();
+    REQUIRE(fs::create_directories(directory));
+    auto path = directory / "facts.json";
+
+    WHEN("loading valid facts") {
+        write_file(
+            path,
+            "{ \"String\": \"foo\", \"integer\": 42, \"large\": 18446744073709551615, \"float\": 1.5, \"bool\": true, \"null\": null, "
+            "\"array\": [ 1, \"two\", [ 3 ] ], \"hash\": { \"key\": { \"nested\": \"value\" } } }"
+        );
+        facts::json provider{ path.string() };
+
+        THEN("fact names should be lowercase") {
+            REQUIRE_FALSE(provider.lookup("String"));
+            auto value = provider.lookup("string");
+            REQUIRE(value);
+            REQUIRE(*value->as<string>() == "foo");
+        }
+        THEN("scalar facts should be converted") {
+            auto value = provider.lookup("integer");
+            REQUIRE(value);
+            REQUIRE(*value->as<int64_t>() == 42);
+            value = provider.lookup("large");
+            REQUIRE(value);
+            REQUIRE(value->as<double>());
+            value = provider.lookup("float");
+            REQUIRE(value);
+            REQUIRE(*value->as<double>() == 1.5);
+            value = provider.lookup("bool");
+            REQUIRE(value);
+            REQUIRE(*value->as<bool>());
+            value = provider.lookup("null");
+            REQUIRE(value);
+            REQUIRE(value->is_undef());
+        }
+        THEN("structured facts should be converted") {
+            auto value = provider.lookup("array");
+            REQUIRE(value);
+            auto array = value->as<values::array>();
+            REQUIRE(array);
+            REQUIRE(array->size() == 3);
+            REQUIRE(*(*array)[0]->as<int64_t>() == 1);
+            REQUIRE(*(*array)[1]->as<string>() == "two");
+            REQUIRE((*array)[2]->as<values::array>());
+
+            value = provider.lookup("hash");
+            REQUIRE(value);
+            auto hash = value->as<values::hash>();
+            REQUIRE(hash);
+            auto key = hash->get(values::value{ string{ "key" } });
+            REQUIRE(key);
+            auto nested = key->as<values::hash>();
+            REQUIRE(nested);
+            auto element = nested->get(values::value{ string{ "nested" } });
+            REQUIRE(element);
+            REQUIRE(*element->as<string>() == "value");
+        }
+        THEN("missing facts should not be found") {
+            REQUIRE_FALSE(provider.lookup("missing"));
+        }
+        THEN("only accessed facts should be enumerated when requested") {
+            REQUIRE(provider.lookup("integer"));
+            REQUIRE_FALSE(provider.lookup("missing"));
+
+            vector<string> names;
+            provider.each(true, [&](string const& name, shared_ptr<values::value const> const&) {
+                names.push_back(name);
+                return true;
+            });
+            REQUIRE(names == vector<string>{ "integer" });
+
+            size_t count = 0;
+            provider.each(false, [&](string const&, shared_ptr<values::value const> const&) {
+                ++count;
+                return true;
+            });
+            REQUIRE(count == 8);
+        }
+    }
+    WHEN("the facts file does not exist") {
+        THEN("it should throw an exception") {
+            REQUIRE_THROWS_AS(facts::json{ (directory / "missing.json").string() }, facts::json_parse_exception);
+        }
+    }
+    WHEN("the facts are not an object") {
+        write_file(path, "[ 1, 2, 3 ]");
+        THEN("it should throw an exception") {
+            REQUIRE_THROWS_AS(facts::json{ path.string() }, facts::json_parse_exception);
+        }
+    }
+    WHEN("the facts are malformed") {
+        write_file(path, "{\n  \"foo\": \"bar\",\n  \"baz\"\n}");
+        THEN("it should throw an exception with the location of the error") {
+            try {
+                facts::json provider{ path.string() };
+                FAIL("expected an exception");
+            } catch (facts::json_parse_exception const& ex) {
+                REQUIRE(ex.path() == path.string());
+                REQUIRE(ex.line() == 4);
+            }
+        }
+    }
+
+    sys::error_code ec;
+    fs::remove_all(directory, ec);
+}
@@ -0,0 +1,141 @@
+#include <catch.hpp>
+#include <puppet/facts/store.hpp>
+#include <puppet/cast.hpp>
+#include <unordered_map>
+
+using namespace std;
+using namespace puppet;
+using namespace puppet::runtime;
+
+// Provides facts from a map
+struct map_facts : facts::provider
+{
+    shared_ptr<values::value const> lookup(string const& name) override
+    {
+        auto it = facts.find(name);
+        return it == facts.end() ? nullptr : it->second;
+    }
+
+    void each(bool accessed, function<bool(string const&, shared_ptr<values::value const> const&)> const& callback) override
+    {
+        for (auto const& kvp : facts) {
+            if (!callback(kvp.first, kvp.second)) {
+                break;
+            }
+        }
+    }
+
+    void add(string const& name, values::value value)
+    {
+        facts.emplace(name, make_shared<values::value const>(rvalue_cast(value)));
+    }
+
+    unordered_map<string, shared_ptr<values::value const>> facts;
+};
+
+static values::value make_os(string const& release)
+{
+    values::hash version;
+    version.set(values::value{ string{ "full" } }, values::value{ release });
+    version.set(values::value{ string{ "major" } }, values::value{ string{ "7" } });
+
+    values::hash os;
+    os.set(values::value{ string{ "family" } }, values::value{ string{ "RedHat" } });
+    os.set(values::value{ string{ "release" } }, values::value{ rvalue_cast(version) });
+    return os;
+}
+
+SCENARIO("shared fact store", "[facts]")
+{
+    auto store = make_shared<facts::store>();
+
+    WHEN("interning identical values") {
+        auto first = store->intern(make_os("7.2"));
+        auto second = store->intern(make_os("7.2"));
+        THEN("the same node should be returned") {
+            REQUIRE(first == second);
+        }
+        THEN("the values of the node should be shared") {
+            auto value = store->value(first);
+            REQUIRE(value == store->value(second));
+            REQUIRE(*value == make_os("7.2"));
+        }
+    }
+    WHEN("interning values that differ only in a nested value") {
+        auto first = store->intern(make_os("7.2"));
+        auto size = store->size();
+        auto second = store->intern(make_os("7.3"));
+        THEN("only the differing subtree should be added") {
+            REQUIRE(first != second);
+            // The new release string, the release hash, and the os hash
+            REQUIRE(store->size() == size + 3);
+        }
+    }
+    WHEN("interning values that are equal but not identical") {
+        auto lower = store->intern(values::value{ string{ "redhat" } });
+        auto upper = store->intern(values::value{ string{ "RedHat" } });
+        auto integer = store->intern(values::value{ static_cast<int64_t>(1) });
+        auto floating = store->intern(values::value{ 1.0 });
+        THEN("they should not be shared") {
+            REQUIRE(lower != upper);
+            REQUIRE(integer != floating);
+            REQUIRE(*store->value(upper)->as<string>() == "RedHat");
+            REQUIRE(store->value(floating)->as<double>());
+        }
+    }
+    WHEN("the last reference to a node is released") {
+        auto node = store->intern(make_os("7.2"));
+        REQUIRE(store->size() > 0);
+        node.reset();
+        THEN("the node and its children should be removed from the store") {
+            REQUIRE(store->size() == 0);
+        }
+    }
+    WHEN("viewing the facts of several nodes") {
+        map_facts first;
+        first.add("os", make_os("7.2"));
+        first.add("hostname", string{ "first" });
+
+        map_facts second;
+        second.add("os", make_os("7.2"));
+        second.add("hostname", string{ "second" });
+
+        facts::view first_view{ store, first };
+        facts::view second_view{ store, second };
+
+        THEN("identical facts should share the same value") {
+            auto value = first_view.lookup("os");
+            REQUIRE(value);
+            REQUIRE(value == second_view.lookup("os"));
+        }
+        THEN("each view should have its own facts") {
+            REQUIRE(*first_view.lookup("hostname")->as<string>() == "first");
+            REQUIRE(*second_view.lookup("hostname")->as<string>() == "second");
+            REQUIRE_FALSE(first_view.lookup("missing"));
+        }
+        THEN("only accessed facts should be enumerated when requested") {
+            REQUIRE(first_view.lookup("hostname"));
+
+            vector<string> names;
+            first_view.each(true, [&](string const& name, shared_ptr<values::value const> const&) {
+                names.push_back(name);
+                return true;
+            });
+            REQUIRE(names == vector<string>{ "hostname" });
+
+            size_t count = 0;
+            first_view.each(false, [&](string const&, shared_ptr<values::value const> const& value) {
+                REQUIRE(value);
+                ++count;
+                return true;
+            });
+            REQUIRE(count == 2);
+        }
+    }
+    WHEN("constructing a view without a store") {
+        map_facts facts;
+        THEN("it should throw an exception") {
+            REQUIRE_THROWS_AS(facts::view(nullptr, facts), runtime_error);
+        }
+    }
+}
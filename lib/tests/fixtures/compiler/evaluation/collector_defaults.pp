@@ -0,0 +1,27 @@
+define foo($param = undef) {
+    notice "${title}: ${param}"
+}
+
+Foo {
+    param => defaulted
+}
+
+@foo { from_default: }
+
+@foo { explicit:
+    param => explicit
+}
+
+@foo { overridden:
+    param => original
+}
+
+# The default is applied to the virtual resource and is visible to the query
+Foo<| param == defaulted |>
+
+# Overrides are applied to the collected resources
+Foo<| param == original |> {
+    param => override
+}
+
+Foo<| title == explicit |>
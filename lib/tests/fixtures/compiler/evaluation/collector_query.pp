@@ -0,0 +1,33 @@
+define foo($param = undef, $list = []) {
+    notice "${title}: ${param} ${list}"
+}
+
+@foo { equal:
+    param => one
+}
+
+@foo { not_equal:
+    param => two
+}
+
+@foo { both:
+    param => one,
+    list  => [a, b]
+}
+
+@foo { either:
+    param => three,
+    list  => [c]
+}
+
+@foo { unrealized:
+    param => one,
+    list  => [d]
+}
+
+# Equality against an array-valued attribute matches any element
+Foo<| list == b |>
+
+# Inequality, conjunction, and disjunction
+Foo<| param != one and param != three |>
+Foo<| (param == one and title == equal) or list == c |>
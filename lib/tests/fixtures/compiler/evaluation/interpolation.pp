@@ -0,0 +1,16 @@
+$string = 'hello'
+$integer = 42
+$float = 1.5
+$boolean = true
+$undef = undef
+$array = [1, 'two', 3.25, [undef, false]]
+$hash = { a => 1, b => [2, 'three'], c => { d => undef } }
+
+notice "string: ${string}"
+notice "integer: ${integer}"
+notice "float: ${float} ${$float * 2} ${1e3}"
+notice "boolean: ${boolean} ${!$boolean}"
+notice "undef: [${undef}]"
+notice "array: ${array}"
+notice "hash: ${hash}"
+notice "mixed: ${string}${integer}${float}${undef}${array[1]}"
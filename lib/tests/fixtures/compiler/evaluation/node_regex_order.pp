@@ -0,0 +1,16 @@
+# The node name is 'test'; the first regex to match anywhere in the name wins, even if a later regex matches earlier in the name
+node /^nomatch/ {
+    notice 'not matched'
+}
+
+node /st$/ {
+    notice 'hello from the first matching node'
+}
+
+node /^te/ {
+    notice 'hello from a later node'
+}
+
+node default {
+    notice 'hello from default node'
+}
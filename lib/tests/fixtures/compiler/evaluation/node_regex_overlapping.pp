@@ -0,0 +1,12 @@
+# Overlapping regexes: a later regex matching earlier in the name, and a later regex that cannot be combined
+node /es/ {
+    notice 'hello from the first matching node'
+}
+
+node /^t/ {
+    notice 'hello from a later node'
+}
+
+node /^(t)es\1$/ {
+    notice 'hello from a later uncombined node'
+}
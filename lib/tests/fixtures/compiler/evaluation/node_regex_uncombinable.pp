@@ -0,0 +1,8 @@
+# A regex with a backreference is searched on its own, but still wins when it comes first
+node /^(t)es\1$/ {
+    notice 'hello from the first matching node'
+}
+
+node /test/ {
+    notice 'hello from a later node'
+}
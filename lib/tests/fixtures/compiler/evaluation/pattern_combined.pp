@@ -0,0 +1,16 @@
+# Combinable patterns are searched together and the rest are searched on their own
+$type = Pattern[/^foo$/, /(a)\1/, /^bar/, /(?<name>x)\k<name>$/, /(?i)^baz/, /(?x) ^ q u x $/, /\(?x\)/]
+
+notice 'foo' =~ $type
+notice 'bar baz' =~ $type
+notice 'BAZ' =~ $type
+notice 'xaay' =~ $type
+notice 'yxx' =~ $type
+notice 'qux' =~ $type
+notice '(x)' =~ $type
+notice 'x' =~ $type
+notice 'foobar' =~ $type
+notice 'q u x' =~ $type
+
+notice ['foo', 'xx', 'qux'] =~ Array[$type]
+notice ['foo', 'nope'] =~ Array[$type]
@@ -0,0 +1,4 @@
+$subject = 'aaaaaaaaaaaaaaaaaaaaaaaa!'
+if $subject =~ /^(a+)+\1$/ {
+    notice matched
+}
@@ -0,0 +1 @@
+notice split('aaaaaaaaaaaaaaaaaaaaaaaa!', /^(a+)+\1$/)
@@ -0,0 +1,6 @@
+define foo(Pattern[/^(a+)+\1$/, /^b/] $param) {
+}
+
+foo { bar:
+    param => 'aaaaaaaaaaaaaaaaaaaaaaaa!'
+}
@@ -0,0 +1,131 @@
+# Tests for Variant
+
+unless 1 =~ Variant[Integer, String] {
+    fail incorrect
+}
+
+unless foo =~ Variant[Integer, String] {
+    fail incorrect
+}
+
+if undef =~ Variant[Integer, String] {
+    fail incorrect
+}
+
+if 1.0 =~ Variant[Integer, String] {
+    fail incorrect
+}
+
+if [1] =~ Variant[Integer, String] {
+    fail incorrect
+}
+
+unless undef =~ Variant[Integer, Undef] {
+    fail incorrect
+}
+
+unless 5 =~ Variant[Integer[0, 10], Integer[20, 30]] {
+    fail incorrect
+}
+
+if 15 =~ Variant[Integer[0, 10], Integer[20, 30]] {
+    fail incorrect
+}
+
+unless foo =~ Variant[Enum[foo, bar], Pattern[/^baz/]] {
+    fail incorrect
+}
+
+if qux =~ Variant[Enum[foo, bar], Pattern[/^baz/]] {
+    fail incorrect
+}
+
+# Tests for Variant with an alias
+
+type Name = Pattern[/^[a-z]+$/]
+type NameOrId = Variant[Integer, Name]
+
+unless 1 =~ NameOrId {
+    fail incorrect
+}
+
+unless foo =~ NameOrId {
+    fail incorrect
+}
+
+if 'Foo' =~ NameOrId {
+    fail incorrect
+}
+
+if undef =~ NameOrId {
+    fail incorrect
+}
+
+unless [foo, 1] =~ Array[NameOrId] {
+    fail incorrect
+}
+
+if [foo, 1.5] =~ Array[NameOrId] {
+    fail incorrect
+}
+
+# Tests for Struct
+
+type Settings = Struct[{ name => String, Optional[port] => Integer, NotUndef[host] => String }]
+
+$value1 = { name => foo, host => bar }
+unless $value1 =~ Settings {
+    fail incorrect
+}
+
+$value2 = { name => foo, port => 80, host => bar }
+unless $value2 =~ Settings {
+    fail incorrect
+}
+
+$value3 = { name => foo, port => undef, host => bar }
+if $value3 =~ Settings {
+    fail incorrect
+}
+
+$value4 = { name => foo }
+if $value4 =~ Settings {
+    fail incorrect
+}
+
+$value5 = { name => foo, host => bar, extra => baz }
+if $value5 =~ Settings {
+    fail incorrect
+}
+
+$value6 = { name => foo, port => '80', host => bar }
+if $value6 =~ Settings {
+    fail incorrect
+}
+
+# Tests for Optional[Struct]
+
+unless undef =~ Optional[Settings] {
+    fail incorrect
+}
+
+$value7 = { name => foo, host => bar }
+unless $value7 =~ Optional[Settings] {
+    fail incorrect
+}
+
+$value8 = { name => 1, host => bar }
+if $value8 =~ Optional[Settings] {
+    fail incorrect
+}
+
+if foo =~ Optional[Settings] {
+    fail incorrect
+}
+
+$value9 = { name => foo }
+unless $value9 =~ Optional[Struct[{ name => String, Optional[port] => Integer }]] {
+    fail incorrect
+}
+
+notice 'passed'
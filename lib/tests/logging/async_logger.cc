@@ -0,0 +1,162 @@
+#include <catch.hpp>
+#include <puppet/logging/async_logger.hpp>
+#include <boost/lexical_cast.hpp>
+#include <thread>
+#include <vector>
+#include <mutex>
+
+using namespace std;
+using namespace puppet;
+using namespace puppet::logging;
+
+struct recording_logger : logger
+{
+    vector<pair<logging::level, string>> messages()
+    {
+        lock_guard<mutex> lock{ _mutex };
+        return _messages;
+    }
+
+ protected:
+    void log_message(logging::level level, size_t line, size_t column, size_t length, string const& text, string const& path, string const& message) override
+    {
+        lock_guard<mutex> lock{ _mutex };
+        _messages.emplace_back(level, message);
+    }
+
+    void log_backtrace(vector<compiler::evaluation::stack_frame> const& backtrace) override
+    {
+    }
+
+ private:
+    mutex _mutex;
+    vector<pair<logging::level, string>> _messages;
+};
+
+static void log_from_threads(logger& logger, size_t thread_count, size_t message_count)
+{
+    vector<thread> threads;
+    for (size_t i = 0; i < thread_count; ++i) {
+        threads.emplace_back([&, i]() {
+            for (size_t j = 0; j < message_count; ++j) {
+                logger.log(j % 2 == 0 ? logging::level::error : logging::level::warning, boost::lexical_cast<string>(i) + ":" + boost::lexical_cast<string>(j));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+SCENARIO("asynchronous logger", "[logging]")
+{
+    size_t const thread_count = 4;
+    size_t const message_count = 1000;
+
+    recording_logger target;
+
+    WHEN("logging from a single thread") {
+        async_logger logger{ target, 4 };
+        for (size_t i = 0; i < message_count; ++i) {
+            logger.log(logging::level::notice, boost::lexical_cast<string>(i));
+        }
+        logger.flush();
+
+        THEN("the messages should be written in order") {
+            auto messages = target.messages();
+            REQUIRE(messages.size() == message_count);
+            for (size_t i = 0; i < message_count; ++i) {
+                REQUIRE(messages[i].first == logging::level::notice);
+                REQUIRE(messages[i].second == boost::lexical_cast<string>(i));
+            }
+        }
+    }
+    WHEN("logging from multiple threads into a buffer that fills") {
+        async_logger logger{ target, 4 };
+        log_from_threads(logger, thread_count, message_count);
+        logger.flush();
+
+        THEN("every message should be written and each thread's messages should be in order") {
+            auto messages = target.messages();
+            REQUIRE(messages.size() == thread_count * message_count);
+
+            vector<size_t> next(thread_count, 0);
+            for (auto const& message : messages) {
+                auto separator = message.second.find(':');
+                REQUIRE(separator != string::npos);
+                auto thread = boost::lexical_cast<size_t>(message.second.substr(0, separator));
+                auto index = boost::lexical_cast<size_t>(message.second.substr(separator + 1));
+                REQUIRE(thread < thread_count);
+                REQUIRE(index == next[thread]);
+                REQUIRE(message.first == (index % 2 == 0 ? logging::level::error : logging::level::warning));
+                ++next[thread];
+            }
+        }
+        THEN("the warning and error counts should include every thread's messages") {
+            REQUIRE(logger.errors() == thread_count * message_count / 2);
+            REQUIRE(logger.warnings() == thread_count * message_count / 2);
+        }
+    }
+    WHEN("the logger is destructed with queued messages") {
+        {
+            async_logger logger{ target };
+            log_from_threads(logger, thread_count, message_count);
+        }
+        THEN("every queued message should be written") {
+            REQUIRE(target.messages().size() == thread_count * message_count);
+        }
+    }
+    WHEN("logging below the logger's level") {
+        async_logger logger{ target };
+        logger.level(logging::level::error);
+        logger.log(logging::level::warning, "filtered");
+        logger.log(logging::level::error, "written");
+        logger.flush();
+
+        THEN("only messages at or above the level should be written and counted") {
+            auto messages = target.messages();
+            REQUIRE(messages.size() == 1);
+            REQUIRE(messages[0].second == "written");
+            REQUIRE(logger.errors() == 1);
+            REQUIRE(logger.warnings() == 0);
+        }
+    }
+}
+
+SCENARIO("child logger", "[logging]")
+{
+    recording_logger target;
+    async_logger parent{ target };
+    parent.level(logging::level::warning);
+
+    WHEN("constructing a child logger") {
+        child_logger child{ parent };
+        THEN("it should start with the parent's level") {
+            REQUIRE(child.level() == logging::level::warning);
+        }
+    }
+    WHEN("logging through child loggers that share a parent") {
+        child_logger first{ parent };
+        child_logger second{ parent };
+        log_from_threads(first, 2, 10);
+        second.log(logging::level::error, "second");
+        second.log(logging::level::notice, "filtered");
+        parent.flush();
+
+        THEN("each child should keep its own warning and error counts") {
+            REQUIRE(first.errors() == 10);
+            REQUIRE(first.warnings() == 10);
+            REQUIRE(second.errors() == 1);
+            REQUIRE(second.warnings() == 0);
+        }
+        THEN("the parent should count every forwarded message") {
+            REQUIRE(parent.errors() == 11);
+            REQUIRE(parent.warnings() == 10);
+        }
+        THEN("the messages should be written to the parent's target") {
+            auto messages = target.messages();
+            REQUIRE(messages.size() == 21);
+            REQUIRE(messages.back().second == "second");
+        }
+    }
+}
@@ -0,0 +1,96 @@
+#include <catch.hpp>
+#include <puppet/logging/logger.hpp>
+#include <puppet/compiler/evaluation/scope.hpp>
+#include <puppet/compiler/evaluation/stack_frame.hpp>
+#include <sstream>
+
+using namespace std;
+using namespace puppet;
+using namespace puppet::logging;
+using namespace puppet::compiler::evaluation;
+
+SCENARIO("JSON logger", "[logging]")
+{
+    ostringstream output;
+
+    WHEN("logging a message") {
+        json_logger logger{ output };
+        logger.log(logging::level::notice, "hello world");
+        THEN("the message should be buffered until flushed") {
+            REQUIRE(output.str().empty());
+            logger.flush();
+            REQUIRE(output.str() == "{\"level\":\"notice\",\"message\":\"hello world\"}\n");
+        }
+    }
+    WHEN("the logger is destroyed") {
+        {
+            json_logger logger{ output };
+            logger.log(logging::level::warning, "pending");
+        }
+        THEN("buffered messages should be written") {
+            REQUIRE(output.str() == "{\"level\":\"warning\",\"message\":\"pending\"}\n");
+        }
+    }
+    WHEN("logging an error or above") {
+        json_logger logger{ output };
+        logger.level(logging::level::debug);
+        logger.log(logging::level::info, "first");
+        logger.log(logging::level::error, "second");
+        THEN("the buffer should be flushed immediately") {
+            REQUIRE(output.str() ==
+                "{\"level\":\"info\",\"message\":\"first\"}\n"
+                "{\"level\":\"error\",\"message\":\"second\"}\n"
+            );
+        }
+        AND_WHEN("logging a critical message") {
+            logger.log(logging::level::critical, "third");
+            THEN("the buffer should be flushed immediately") {
+                REQUIRE(output.str() ==
+                    "{\"level\":\"info\",\"message\":\"first\"}\n"
+                    "{\"level\":\"error\",\"message\":\"second\"}\n"
+                    "{\"level\":\"critical\",\"message\":\"third\"}\n"
+                );
+            }
+        }
+    }
+    WHEN("logging a message with quotes and control characters") {
+        json_logger logger{ output };
+        logger.log(logging::level::error, string{ "\"quoted\" back\\slash\n\r\t\x01\x1f" });
+        THEN("the message should be escaped") {
+            REQUIRE(output.str() == "{\"level\":\"error\",\"message\":\"\\\"quoted\\\" back\\\\slash\\n\\r\\t\\u0001\\u001f\"}\n");
+        }
+    }
+    WHEN("logging a message with a source location") {
+        json_logger logger{ output, "foo.example.com" };
+        logger.log(logging::level::error, 3, 7, 2, "text", "/tmp/site.pp", "oops");
+        THEN("the path, line, column, and node should be written") {
+            REQUIRE(output.str() == "{\"level\":\"error\",\"path\":\"/tmp/site.pp\",\"line\":3,\"column\":7,\"node\":\"foo.example.com\",\"message\":\"oops\"}\n");
+        }
+    }
+    WHEN("logging a message with a path but no line or column") {
+        json_logger logger{ output };
+        logger.log(logging::level::error, 0, 0, 0, {}, "/tmp/site.pp", "oops");
+        THEN("only the path should be written") {
+            REQUIRE(output.str() == "{\"level\":\"error\",\"path\":\"/tmp/site.pp\",\"message\":\"oops\"}\n");
+        }
+    }
+    WHEN("logging a backtrace") {
+        json_logger logger{ output };
+        auto scope = make_shared<compiler::evaluation::scope>(shared_ptr<facts::provider>{});
+        logger.log({
+            stack_frame{ "first", scope },
+            stack_frame{ "second", scope }
+        });
+        THEN("the frames should be written as an array and flushed") {
+            REQUIRE(output.str() == "{\"level\":\"error\",\"backtrace\":[\"in 'first' (no source)\",\"in 'second' (no source)\"]}\n");
+        }
+    }
+    WHEN("logging an empty backtrace") {
+        json_logger logger{ output };
+        logger.log(vector<stack_frame>{});
+        logger.flush();
+        THEN("nothing should be written") {
+            REQUIRE(output.str().empty());
+        }
+    }
+}
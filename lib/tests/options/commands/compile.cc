@@ -2,11 +2,17 @@
 #include <puppet/options/commands/compile.hpp>
 #include <puppet/options/commands/help.hpp>
 #include <puppet/options/parser.hpp>
+#include <puppet/cast.hpp>
+#include <boost/filesystem.hpp>
 #include <sstream>
+#include <fstream>
+#include <unordered_map>
 
 using namespace std;
 using namespace puppet;
 using namespace puppet::options;
+using namespace puppet::runtime;
+namespace po = boost::program_options;
 
 extern char const* const COMPILE_COMMAND_HELP =
     "\n"
@@ -26,12 +32,20 @@ extern char const* const COMPILE_COMMAND_HELP =
     "                                        The environment to use.\n"
     "  --environment-path arg                The list of paths to use for finding \n"
     "                                        environments.\n"
-    "  -f [ --facts ] arg                    The path to the YAML facts file to use.\n"
-    "                                        Defaults to the current system's facts.\n"
+    "  -f [ --facts ] arg                    The path to the YAML or JSON facts file\n"
+    "                                        to use. Defaults to the current \n"
+    "                                        system's facts.\n"
+    "  --facts-cache                         Cache the converted facts in a binary \n"
+    "                                        file next to the facts file.\n"
+    "  --format arg (=json)                  The catalog output format.\n"
+    "                                        Supported formats: json, compact-json, \n"
+    "                                        msgpack.\n"
     "  -g [ --graph-file ] arg               The path to write a DOT language file \n"
     "                                        for viewing the catalog dependency \n"
     "                                        graph.\n"
     "  --help                                Display command help.\n"
+    "  --log-format arg (=text)              The log output format.\n"
+    "                                        Supported formats: text, json.\n"
     "  -l [ --log-level ] arg (=notice)      Set logging level.\n"
     "                                        Supported levels: debug, info, notice, \n"
     "                                        warning, error, alert, emergency, \n"
@@ -92,6 +106,16 @@ SCENARIO("using the compile command", "[options]")
             REQUIRE_THROWS_AS(parser.parse({ "compile", "--color", "--no-color" }), option_exception);
         }
     }
+    WHEN("given an invalid catalog format") {
+        THEN("it should throw an exception") {
+            REQUIRE_THROWS_AS(parser.parse({ "compile", "--format", "xml" }), option_exception);
+        }
+    }
+    WHEN("given an invalid log format") {
+        THEN("it should throw an exception") {
+            REQUIRE_THROWS_AS(parser.parse({ "compile", "--log-format", "xml" }), option_exception);
+        }
+    }
     WHEN("given a code directory that does not exist") {
         THEN("it should throw an exception") {
             REQUIRE_THROWS_AS(parser.parse({ "compile", "--code-dir", "does_not_exist" }), option_exception);
@@ -103,3 +127,138 @@ SCENARIO("using the compile command", "[options]")
         }
     }
 }
+
+// Exposes how the compile command determines the node name and facts
+struct node_command : commands::compile
+{
+    using compile::compile;
+    using compile::get_facts;
+    using compile::get_node;
+};
+
+// Provides facts from a map and records which facts were looked up
+struct map_provider : facts::provider
+{
+    shared_ptr<values::value const> lookup(string const& name) override
+    {
+        looked_up.push_back(name);
+        auto it = facts.find(name);
+        return it == facts.end() ? nullptr : it->second;
+    }
+
+    void each(bool accessed, function<bool(string const&, shared_ptr<values::value const> const&)> const& callback) override
+    {
+        for (auto const& kvp : facts) {
+            if (!callback(kvp.first, kvp.second)) {
+                break;
+            }
+        }
+    }
+
+    void add(string const& name, values::value value)
+    {
+        facts.emplace(name, make_shared<values::value const>(rvalue_cast(value)));
+    }
+
+    unordered_map<string, shared_ptr<values::value const>> facts;
+    vector<string> looked_up;
+};
+
+SCENARIO("determining the node name for the compile command", "[options]")
+{
+    options::parser parser;
+    node_command command{ parser };
+    map_provider provider;
+
+    values::hash networking;
+    networking.set(values::value{ string{ "fqdn" } }, values::value{ string{ "networking.example.com" } });
+    networking.set(values::value{ string{ "hostname" } }, values::value{ string{ "networking" } });
+    networking.set(values::value{ string{ "domain" } }, values::value{ string{ "example.org" } });
+    provider.add("networking", rvalue_cast(networking));
+
+    auto parse = [&](vector<string> const& arguments) {
+        po::variables_map options;
+        po::store(po::command_line_parser(arguments).options(command.create_options()).run(), options);
+        po::notify(options);
+        return options;
+    };
+
+    WHEN("the node option is given") {
+        provider.add("fqdn", string{ "fqdn.example.com" });
+        THEN("it should be used without looking up any facts") {
+            REQUIRE(command.get_node(parse({ "--node", "explicit.example.com" }), provider) == "explicit.example.com");
+            REQUIRE(provider.looked_up.empty());
+        }
+    }
+    WHEN("the legacy fqdn fact is present") {
+        provider.add("fqdn", string{ "fqdn.example.com" });
+        provider.add("hostname", string{ "host" });
+        provider.add("domain", string{ "example.net" });
+        THEN("it should be preferred over the networking fact") {
+            REQUIRE(command.get_node(parse({}), provider) == "fqdn.example.com");
+            REQUIRE(provider.looked_up == vector<string>{ "fqdn" });
+        }
+    }
+    WHEN("the legacy hostname and domain facts are present") {
+        provider.add("hostname", string{ "host" });
+        provider.add("domain", string{ "example.net" });
+        THEN("they should be preferred over the networking fact") {
+            REQUIRE(command.get_node(parse({}), provider) == "host.example.net");
+            REQUIRE(provider.looked_up == (vector<string>{ "fqdn", "hostname", "domain" }));
+        }
+    }
+    WHEN("only the networking fact is present") {
+        THEN("the networking fqdn should be used") {
+            REQUIRE(command.get_node(parse({}), provider) == "networking.example.com");
+        }
+    }
+    WHEN("no facts name the node") {
+        provider.facts.clear();
+        THEN("it should throw an exception") {
+            REQUIRE_THROWS_AS(command.get_node(parse({}), provider), option_exception);
+        }
+    }
+}
+
+SCENARIO("getting facts for the compile command", "[options]")
+{
+    namespace fs = boost::filesystem;
+
+    options::parser parser;
+    node_command command{ parser };
+
+    auto directory = fs::temp_directory_path() / fs::unique_path();
+    REQUIRE(fs::create_directories(directory));
+    auto first_path = directory / "first.json";
+    auto second_path = directory / "second.json";
+    {
+        ofstream first{ first_path.string() };
+        first << "{ \"os\": { \"family\": \"RedHat\" }, \"hostname\": \"first\" }";
+        ofstream second{ second_path.string() };
+        second << "{ \"os\": { \"family\": \"RedHat\" }, \"hostname\": \"second\" }";
+    }
+
+    auto get_facts = [&](fs::path const& path) {
+        po::variables_map options;
+        po::store(po::command_line_parser(vector<string>{ "--facts", path.string() }).options(command.create_options()).run(), options);
+        po::notify(options);
+        return command.get_facts(options);
+    };
+
+    WHEN("loading facts files for several nodes") {
+        auto first = get_facts(first_path);
+        auto second = get_facts(second_path);
+        THEN("identical facts should share the same value") {
+            auto os = first->lookup("os");
+            REQUIRE(os);
+            REQUIRE(os == second->lookup("os"));
+        }
+        THEN("each node should have its own facts") {
+            REQUIRE(*first->lookup("hostname")->as<string>() == "first");
+            REQUIRE(*second->lookup("hostname")->as<string>() == "second");
+        }
+    }
+
+    boost::system::error_code ec;
+    fs::remove_all(directory, ec);
+}
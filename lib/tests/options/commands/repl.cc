@@ -26,8 +26,12 @@ extern char const* const REPL_COMMAND_HELP =
     "                                        The environment to use.\n"
     "  --environment-path arg                The list of paths to use for finding \n"
     "                                        environments.\n"
-    "  -f [ --facts ] arg                    The path to the YAML facts file to use.\n"
-    "                                        Defaults to the current system's facts.\n"
+    "  -f [ --facts ] arg                    The path to the YAML or JSON facts file\n"
+    "                                        to use. Defaults to the current \n"
+    "                                        system's facts.\n"
+    "  --format arg (=json)                  The catalog output format.\n"
+    "                                        Supported formats: json, compact-json, \n"
+    "                                        msgpack.\n"
     "  -g [ --graph-file ] arg               The path to write a DOT language file \n"
     "                                        for viewing the catalog dependency \n"
     "                                        graph.\n"
@@ -91,6 +95,11 @@ SCENARIO("using the repl command", "[options]")
             REQUIRE_THROWS_AS(parser.parse({ "repl", "--color", "--no-color" }), option_exception);
         }
     }
+    WHEN("given an invalid catalog format") {
+        THEN("it should throw an exception") {
+            REQUIRE_THROWS_AS(parser.parse({ "repl", "--format", "xml" }), option_exception);
+        }
+    }
     WHEN("given a code directory that does not exist") {
         THEN("it should throw an exception") {
             REQUIRE_THROWS_AS(parser.parse({ "repl", "--code-dir", "does_not_exist" }), option_exception);
@@ -0,0 +1,71 @@
+#include <catch.hpp>
+#include <puppet/runtime/values/value.hpp>
+#include <puppet/unicode/string.hpp>
+#include <boost/lexical_cast.hpp>
+
+using namespace std;
+using namespace puppet;
+using namespace puppet::runtime;
+
+SCENARIO("using a string value", "[values]")
+{
+    WHEN("the string is invariant") {
+        values::string_value value{ "foobar" };
+        THEN("it should be invariant and have a grapheme per code unit") {
+            REQUIRE(value.invariant());
+            REQUIRE(value.graphemes() == 6);
+        }
+    }
+    WHEN("the string is not invariant") {
+        values::string_value value{ u8"ño" };
+        THEN("it should count graphemes rather than code units") {
+            REQUIRE_FALSE(value.invariant());
+            REQUIRE(value.graphemes() == 2);
+        }
+        THEN("the hash should be the hash of the unicode string") {
+            REQUIRE(value.hash() == hash_value(unicode::string{ u8"ño" }));
+        }
+    }
+    WHEN("the string is not valid UTF-8") {
+        values::string_value value{ "\xff" };
+        THEN("counting graphemes should throw") {
+            REQUIRE_THROWS_AS(value.graphemes(), unicode::unicode_exception);
+        }
+    }
+    WHEN("copying a string value") {
+        values::string_value value{ u8"ñ" };
+        auto hash = value.hash();
+        values::string_value copy{ value };
+        THEN("the copy should have the same metadata") {
+            REQUIRE(copy.graphemes() == 1);
+            REQUIRE(copy.hash() == hash);
+        }
+    }
+    WHEN("releasing the string") {
+        values::string_value value{ u8"ñ" };
+        value.hash();
+        auto released = value.release();
+        THEN("the string should be moved out") {
+            REQUIRE(released == u8"ñ");
+        }
+    }
+    WHEN("comparing values holding strings") {
+        values::value left{ string{ u8"this contains a ñ: ño" } };
+        values::value right{ string{ u8"this contains a ñ: ño" } };
+        THEN("equality and hashing should handle normalization") {
+            REQUIRE(left == right);
+            REQUIRE(hash_value(left) == hash_value(right));
+            REQUIRE_FALSE(left == values::value{ string{ u8"this contains a ñ: no" } });
+        }
+        THEN("the inferred type should count graphemes") {
+            REQUIRE(boost::lexical_cast<string>(left.infer_type()) == "String[21, 21]");
+        }
+    }
+    WHEN("moving a string out of a value") {
+        values::value value{ string{ "foo" } };
+        auto moved = value.move_as<string>();
+        THEN("the string should be moved") {
+            REQUIRE(moved == "foo");
+        }
+    }
+}
@@ -524,6 +524,64 @@ SCENARIO("using a string", "[values]")
             REQUIRE("z" >= unicode::string{ "a" });
             REQUIRE("z" >= unicode::string{ "z" });
         }
+        THEN("it should ignore case for ordering when requested") {
+            REQUIRE(unicode::string{ "apple" }.compare("BANANA", true) < 0);
+            REQUIRE(unicode::string{ "APPLE" }.compare("banana", true) < 0);
+            REQUIRE(unicode::string{ "Banana" }.compare("apple", true) > 0);
+            REQUIRE(unicode::string{ "aB" }.compare("Ab", true) == 0);
+            REQUIRE(unicode::string{ "ab" }.compare("ABC", true) < 0);
+            REQUIRE(unicode::string{ "ABC" }.compare("ab", true) > 0);
+        }
+        THEN("it should order punctuation before digits and digits before letters") {
+            REQUIRE(unicode::string{ "-" }.compare("0", true) < 0);
+            REQUIRE(unicode::string{ "0" }.compare("a", true) < 0);
+            REQUIRE(unicode::string{ "9" }.compare("A", true) < 0);
+            REQUIRE(unicode::string{ "a-" }.compare("a0", true) < 0);
+            REQUIRE(unicode::string{ "a0" }.compare("aa", true) < 0);
+            REQUIRE(unicode::string{ "a b" }.compare("a-b", true) < 0);
+            REQUIRE(unicode::string{ "a-z" }.compare("a0", true) < 0);
+            REQUIRE(unicode::string{ "a9" }.compare("aa", true) < 0);
+        }
+        THEN("it should ignore ignorable control characters") {
+            REQUIRE(unicode::string{ std::string{ "a\x01" "b" } }.compare("ab", true) == 0);
+            REQUIRE(unicode::string{ std::string{ "ab\x7f" } }.compare("AB", true) == 0);
+            REQUIRE(unicode::string{ std::string{ "\x02\x03" } }.compare("", true) == 0);
+            REQUIRE(unicode::string{ std::string{ "a\x01" "c" } }.compare("ab", true) > 0);
+            REQUIRE(unicode::string{ std::string{ "a\x01" } }.compare("ab", true) < 0);
+        }
+        THEN("it should order strings with invariant and non-invariant prefixes consistently") {
+            REQUIRE(unicode::string{ "abe" }.compare(u8"abé", true) < 0);
+            REQUIRE(unicode::string{ u8"abé" }.compare("abf", true) < 0);
+            REQUIRE(unicode::string{ u8"éa" }.compare("eb", true) < 0);
+            REQUIRE(unicode::string{ u8"Éa" }.compare("eb", true) < 0);
+            REQUIRE(unicode::string{ "eb" }.compare(u8"éa", true) > 0);
+            REQUIRE(unicode::string{ "ae" }.compare(u8"æ", true) < 0);
+            REQUIRE(unicode::string{ u8"ÇA" }.compare(u8"ça", true) == 0);
+        }
+        THEN("it should order invariant strings the same as strings that must be collated with ICU") {
+            // Appending a soft hyphen (which is ignorable) requires the comparison to be made by ICU without changing the result
+            char const* strings[] = { "", " ", "!", "-", "_", "0", "1", "9", "a", "A", "b", "B", "z", "Z", "a b", "a-b", "a0", "aa", "aB", "Ab", "abc", "ABD", "a\x01" "b" };
+            for (auto left : strings) {
+                for (auto right : strings) {
+                    for (auto ignore_case : { true, false }) {
+                        auto expected = unicode::string{ std::string{ left } + u8"\u00ad" }.compare(std::string{ right } + u8"\u00ad", ignore_case);
+                        CAPTURE(left);
+                        CAPTURE(right);
+                        CAPTURE(ignore_case);
+                        REQUIRE(unicode::string{ left }.compare(right, ignore_case) == expected);
+                    }
+                }
+            }
+        }
+        THEN("it should fall back to ICU for case sensitive ordering") {
+            // Case differences are only considered after all other differences, so case sensitive comparisons can't be ranked one code unit at a time
+            REQUIRE(unicode::string{ "a" }.compare("A") < 0);
+            REQUIRE(unicode::string{ "A" }.compare("b") < 0);
+            REQUIRE(unicode::string{ "Aa" }.compare("ab") < 0);
+            REQUIRE(unicode::string{ "ab" }.compare("Aa") > 0);
+            REQUIRE(unicode::string{ "ab" }.compare("AB") < 0);
+            REQUIRE(unicode::string{ std::string{ "a\x01" "b" } }.compare("ab") == 0);
+        }
     }
     WHEN("writing a string") {
         char const* data = u8"foo それは私を傷つけません。bar";
@@ -977,3 +1035,54 @@ SCENARIO("using a string", "[values]")
         }
     }
 }
+
+SCENARIO("finding the invariant length of a string", "[values]")
+{
+    WHEN("the string is empty") {
+        THEN("the invariant length should be zero") {
+            REQUIRE(unicode::invariant_length("", 0) == 0);
+        }
+    }
+    WHEN("the string is entirely invariant") {
+        THEN("the invariant length should be the length of the string for lengths around the block sizes") {
+            for (size_t length : { 1, 7, 8, 9, 15, 16, 17, 31, 32, 33, 47, 48, 49, 63, 64, 65 }) {
+                std::string data(length, 'a');
+                REQUIRE(unicode::invariant_length(data.data(), data.size()) == length);
+            }
+        }
+        THEN("the invariant length should not depend on the alignment of the data") {
+            std::string data(70, 'a');
+            for (size_t offset = 0; offset < 4; ++offset) {
+                REQUIRE(unicode::invariant_length(data.data() + offset, 65) == 65);
+            }
+        }
+    }
+    WHEN("the string contains a non-invariant code unit") {
+        THEN("the invariant length should be the position of the code unit wherever it falls in a block") {
+            for (size_t length : { 15, 16, 17, 31, 32, 33, 64, 65 }) {
+                for (size_t position = 0; position < length; ++position) {
+                    std::string data(length, 'a');
+                    data[position] = static_cast<char>(0x80);
+                    REQUIRE(unicode::invariant_length(data.data(), data.size()) == position);
+                    data[position] = static_cast<char>(0xFF);
+                    REQUIRE(unicode::invariant_length(data.data(), data.size()) == position);
+                }
+            }
+        }
+        THEN("the invariant length should be the position of the first non-invariant code unit") {
+            std::string data(64, 'a');
+            data[16] = static_cast<char>(0xC3);
+            data[17] = static_cast<char>(0xA9);
+            data[40] = static_cast<char>(0xC3);
+            data[41] = static_cast<char>(0xA9);
+            REQUIRE(unicode::invariant_length(data.data(), data.size()) == 16);
+            REQUIRE(unicode::invariant_length(data.data() + 18, data.size() - 18) == 22);
+        }
+        THEN("the invariant length should ignore data past the given length") {
+            std::string data(33, 'a');
+            data[32] = static_cast<char>(0x80);
+            REQUIRE(unicode::invariant_length(data.data(), 32) == 32);
+            REQUIRE(unicode::invariant_length(data.data(), 16) == 16);
+        }
+    }
+}
@@ -0,0 +1,121 @@
+#include <catch.hpp>
+#include <puppet/utility/regex.hpp>
+
+using namespace std;
+using namespace puppet::utility;
+
+SCENARIO("determining if a regex can be combined", "[regex]")
+{
+    WHEN("the pattern is self-contained") {
+        THEN("it should be combinable") {
+            REQUIRE(regex::can_combine("^foo$"));
+            REQUIRE(regex::can_combine("^(foo|bar)+baz$"));
+            REQUIRE(regex::can_combine("^(?:foo)(?=bar)(?!baz)"));
+            REQUIRE(regex::can_combine("(?i)foo"));
+            REQUIRE(regex::can_combine("(?mi-m:foo)"));
+            REQUIRE(regex::can_combine("\\d+\\.\\w+"));
+            REQUIRE(regex::can_combine("\\0"));
+        }
+    }
+    WHEN("the pattern contains a backreference") {
+        THEN("it should not be combinable") {
+            REQUIRE_FALSE(regex::can_combine("(a)\\1"));
+            REQUIRE_FALSE(regex::can_combine("(a)(b)\\2"));
+            REQUIRE_FALSE(regex::can_combine("(?<name>a)\\k<name>"));
+            REQUIRE_FALSE(regex::can_combine("(a)\\k<1>"));
+            REQUIRE_FALSE(regex::can_combine("(a)\\g<1>"));
+        }
+        THEN("an escaped backslash followed by a digit should be combinable") {
+            REQUIRE(regex::can_combine("a\\\\1"));
+            REQUIRE(regex::can_combine("\\\\k"));
+        }
+    }
+    WHEN("the pattern contains a named group or lookbehind") {
+        THEN("a named group should not be combinable") {
+            REQUIRE_FALSE(regex::can_combine("(?<name>a)"));
+            REQUIRE_FALSE(regex::can_combine("(?'name'a)"));
+            REQUIRE_FALSE(regex::can_combine("(?<"));
+        }
+        THEN("a lookbehind should be combinable") {
+            REQUIRE(regex::can_combine("(?<=foo)bar"));
+            REQUIRE(regex::can_combine("(?<!foo)bar"));
+        }
+        THEN("a conditional should not be combinable") {
+            REQUIRE_FALSE(regex::can_combine("(a)?(?(1)b|c)"));
+        }
+    }
+    WHEN("the pattern enables extended mode") {
+        THEN("it should not be combinable") {
+            REQUIRE_FALSE(regex::can_combine("(?x) foo # comment"));
+            REQUIRE_FALSE(regex::can_combine("(?mx)foo"));
+            REQUIRE_FALSE(regex::can_combine("(?x-i:foo)"));
+            REQUIRE_FALSE(regex::can_combine("(?i-x:foo) (?x)bar"));
+        }
+    }
+    WHEN("the pattern contains escaped parentheses") {
+        THEN("they should not be treated as groups") {
+            REQUIRE(regex::can_combine("\\(?x)"));
+            REQUIRE(regex::can_combine("\\(?<name>a\\)"));
+            REQUIRE(regex::can_combine("\\(?'name'\\)"));
+        }
+        THEN("a group following an escaped backslash should still be checked") {
+            REQUIRE_FALSE(regex::can_combine("\\\\(?x)"));
+            REQUIRE_FALSE(regex::can_combine("\\\\(?<name>a)"));
+        }
+    }
+}
+
+SCENARIO("matching with a timeout", "[regex]")
+{
+    WHEN("scoped timeouts are nested") {
+        REQUIRE(regex::timeout().count() == 0);
+        {
+            regex::scoped_timeout outer{ chrono::milliseconds(100) };
+            REQUIRE(regex::timeout().count() == 100);
+            {
+                regex::scoped_timeout inner{ chrono::milliseconds(0) };
+                REQUIRE(regex::timeout().count() == 0);
+            }
+            REQUIRE(regex::timeout().count() == 100);
+        }
+        THEN("the previous timeout should be restored") {
+            REQUIRE(regex::timeout().count() == 0);
+        }
+    }
+    WHEN("a match completes within the timeout") {
+        regex::scoped_timeout timeout{ chrono::milliseconds(60000) };
+        regex expression{ "(b+)(c)?" };
+        auto subject = make_shared<string const>("abbbd");
+        regex::regions regions;
+        THEN("it should return the same results as a match without a timeout") {
+            REQUIRE(expression.search(*subject, &regions));
+            REQUIRE(regions.substrings(*subject) == vector<string>({ "bbb", "bbb", "" }));
+            REQUIRE(expression.search(subject, &regions, 1));
+            REQUIRE(regions.begin(0) == 1);
+            REQUIRE(regions.end(0) == 4);
+            REQUIRE_FALSE(expression.search(subject, &regions, 4));
+            REQUIRE(regions.count() == 0);
+            REQUIRE(expression.match(string{ "bbbc" }));
+            REQUIRE_FALSE(expression.match(subject));
+        }
+    }
+    WHEN("a match exceeds the timeout") {
+        regex expression{ "^(a+)+\\1$" };
+        // This match takes most of a second, which is far longer than the timeout
+        auto subject = make_shared<string const>(string(24, 'a') + "!");
+        regex::scoped_timeout timeout{ chrono::milliseconds(1) };
+        THEN("a regex exception with a code of zero should be thrown") {
+            try {
+                expression.match(subject);
+                FAIL("expected the match to time out");
+            } catch (regex_exception const& ex) {
+                REQUIRE(ex.code() == 0);
+                REQUIRE(string{ ex.what() } == "the match exceeded the timeout of 1 millisecond.");
+            }
+            AND_THEN("later matches should still run") {
+                regex::scoped_timeout longer{ chrono::milliseconds(60000) };
+                REQUIRE(regex{ "^a+!$" }.match(subject));
+            }
+        }
+    }
+}